@@ -0,0 +1,61 @@
+#include <cstddef>
+
+#include <string>
+
+#include <catch2/catch_all.hpp>
+
+#include <codlili/bit_sharray.hpp>
+#include <codlili/sharray.hpp>
+
+
+using namespace com::saxbophone::codlili;
+
+TEST_CASE("bit_sharray compared to sharray<bool>", "[!benchmark]") {
+    std::size_t size = (std::size_t)GENERATE(4096, 1 << 24);
+    sharray<bool> bools(size, false);
+    bools.back() = true;
+    bit_sharray<> bits(size, false);
+    bits.back() = true;
+
+    BENCHMARK("sharray<bool> count() size=" + std::to_string(size)) {
+        return bools.count(true);
+    };
+    BENCHMARK("bit_sharray count() size=" + std::to_string(size)) {
+        return bits.count();
+    };
+    BENCHMARK("sharray<bool> find() size=" + std::to_string(size)) {
+        return bools.find(true) - bools.begin();
+    };
+    BENCHMARK("bit_sharray find_first() size=" + std::to_string(size)) {
+        return bits.find_first();
+    };
+
+    bit_sharray<> other(size, true);
+    BENCHMARK("bit_sharray operator^= size=" + std::to_string(size)) {
+        bits ^= other;
+        return bits.size();
+    };
+
+    BENCHMARK("sharray<bool> push at both ends size=" + std::to_string(size)) {
+        sharray<bool> array;
+        for (std::size_t i = 0; i < size; i++) {
+            if (i % 2 == 0) {
+                array.push_back(true);
+            } else {
+                array.push_front(false);
+            }
+        }
+        return array.size();
+    };
+    BENCHMARK("bit_sharray push at both ends size=" + std::to_string(size)) {
+        bit_sharray<> array;
+        for (std::size_t i = 0; i < size; i++) {
+            if (i % 2 == 0) {
+                array.push_back(true);
+            } else {
+                array.push_front(false);
+            }
+        }
+        return array.size();
+    };
+}
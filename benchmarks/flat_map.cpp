@@ -0,0 +1,97 @@
+#include <cstddef>
+
+#include <functional>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include <codlili/flat_map.hpp>
+
+
+using namespace com::saxbophone::codlili;
+
+namespace {
+    using vector_flat_map = flat_map<int, int, std::less<int>, std::vector<std::pair<int, int>>>;
+
+    // count distinct pseudo-random keys, in no particular order
+    std::vector<int> random_keys(std::size_t count) {
+        std::vector<int> keys(count);
+        unsigned state = 12345;
+        for (std::size_t i = 0; i < count; i++) {
+            state = state * 1103515245 + 12345;
+            // the low bits keep the keys distinct
+            keys[i] = (int)((state & ~0xFFFFFu) | (unsigned)i);
+        }
+        return keys;
+    }
+
+    template <class Map>
+    Map insert_each(const std::vector<int>& keys) {
+        Map map;
+        for (int key : keys) {
+            map.insert({key, key});
+        }
+        return map;
+    }
+
+    template <class Map>
+    long long look_up_each(const Map& map, const std::vector<int>& keys) {
+        long long sum = 0;
+        for (int key : keys) {
+            sum += map.find(key)->second;
+        }
+        return sum;
+    }
+}
+
+TEST_CASE("flat_map compared to std::map and a std::vector-based flat map", "[!benchmark]") {
+    std::size_t size = (std::size_t)GENERATE(1000, 20000);
+    auto keys = random_keys(size);
+
+    BENCHMARK("std::map insert size=" + std::to_string(size)) {
+        return insert_each<std::map<int, int>>(keys).size();
+    };
+    BENCHMARK("vector flat_map insert size=" + std::to_string(size)) {
+        return insert_each<vector_flat_map>(keys).size();
+    };
+    BENCHMARK("flat_map insert size=" + std::to_string(size)) {
+        return insert_each<flat_map<int, int>>(keys).size();
+    };
+
+    auto tree = insert_each<std::map<int, int>>(keys);
+    auto vector_flat = insert_each<vector_flat_map>(keys);
+    auto flat = insert_each<flat_map<int, int>>(keys);
+    BENCHMARK("std::map find size=" + std::to_string(size)) {
+        return look_up_each(tree, keys);
+    };
+    BENCHMARK("vector flat_map find size=" + std::to_string(size)) {
+        return look_up_each(vector_flat, keys);
+    };
+    BENCHMARK("flat_map find size=" + std::to_string(size)) {
+        return look_up_each(flat, keys);
+    };
+
+    std::vector<std::pair<int, int>> elements;
+    for (int key : keys) {
+        elements.emplace_back(key, key);
+    }
+    BENCHMARK("flat_map insert range one at a time size=" + std::to_string(size)) {
+        flat_map<int, int> map = flat;
+        for (const auto& element : elements) {
+            map.insert({element.first + 1, element.second});
+        }
+        return map.size();
+    };
+    BENCHMARK("flat_map insert range merged size=" + std::to_string(size)) {
+        flat_map<int, int> map = flat;
+        std::vector<std::pair<int, int>> shifted = elements;
+        for (auto& element : shifted) {
+            element.first++;
+        }
+        map.insert(shifted.begin(), shifted.end());
+        return map.size();
+    };
+}
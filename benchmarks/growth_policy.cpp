@@ -0,0 +1,84 @@
+#include <cstddef>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+
+#include <catch2/catch_all.hpp>
+
+#include <codlili/growth_policy.hpp>
+#include <codlili/sharray.hpp>
+
+
+using namespace com::saxbophone::codlili;
+
+namespace {
+    // std::allocator which tracks how many allocations are made and the peak memory in use
+    template <typename T>
+    struct TrackingAllocator : std::allocator<T> {
+        static inline std::size_t allocations = 0;
+        static inline std::size_t in_use = 0;
+        static inline std::size_t peak = 0;
+
+        TrackingAllocator() = default;
+        template <typename U>
+        TrackingAllocator(const TrackingAllocator<U>&) {}
+
+        T* allocate(std::size_t n) {
+            allocations++;
+            in_use += n * sizeof(T);
+            peak = std::max(peak, in_use);
+            return std::allocator<T>::allocate(n);
+        }
+        void deallocate(T* p, std::size_t n) {
+            in_use -= n * sizeof(T);
+            std::allocator<T>::deallocate(p, n);
+        }
+
+        static void reset() { allocations = 0; in_use = 0; peak = 0; }
+    };
+
+    // pushes count elements, back_pushes of every 4 at the back and the rest at the front
+    template <class Array>
+    std::size_t push_mix(std::size_t count, std::size_t back_pushes) {
+        Array array;
+        for (std::size_t i = 0; i < count; i++) {
+            if (i % 4 < back_pushes) {
+                array.push_back((int)i);
+            } else {
+                array.push_front((int)i);
+            }
+        }
+        return array.size();
+    }
+
+    template <growth_policy GrowthPolicy>
+    void report_policy(const std::string& name, std::size_t count) {
+        using Array = sharray<int, TrackingAllocator<int>, GrowthPolicy>;
+        const std::pair<const char*, std::size_t> mixes[] = {
+            {"back only", 4}, {"3:1 back:front", 3}, {"1:1 back:front", 2}, {"front only", 0},
+        };
+        for (auto [mix, back_pushes] : mixes) {
+            TrackingAllocator<int>::reset();
+            push_mix<Array>(count, back_pushes);
+            WARN(
+                name << ", " << mix << ": " << TrackingAllocator<int>::allocations
+                << " allocations, peak memory " << TrackingAllocator<int>::peak
+                << " bytes (" << count * sizeof(int) << " bytes of elements)"
+            );
+        }
+        BENCHMARK(name + " 1:1 back:front size=" + std::to_string(count)) {
+            return push_mix<sharray<int, std::allocator<int>, GrowthPolicy>>(count, 2);
+        };
+    }
+}
+
+TEST_CASE("sharray growth policies compared", "[!benchmark]") {
+    std::size_t count = (std::size_t)GENERATE(1000, 1000000);
+
+    report_policy<growth_3x>("growth_3x (default)", count);
+    report_policy<growth_2x>("growth_2x", count);
+    report_policy<growth_1_5x>("growth_1_5x", count);
+    report_policy<power_of_two_growth>("power_of_two_growth", count);
+    report_policy<fixed_growth<4096>>("fixed_growth<4096>", count);
+}
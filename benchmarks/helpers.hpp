@@ -0,0 +1,38 @@
+#ifndef COM_SAXBOPHONE_CODLILI_BENCHMARKS_HELPERS_HPP
+#define COM_SAXBOPHONE_CODLILI_BENCHMARKS_HELPERS_HPP
+
+#include <cstddef>
+
+#include <memory>
+
+
+// counts shared by CountingAllocator of every type, for containers which rebind it
+struct Counts {
+    static inline std::size_t allocations = 0;
+    static inline std::size_t outstanding = 0; // allocations which haven't been deallocated yet
+
+    static void reset() { allocations = 0; outstanding = 0; }
+};
+
+// std::allocator which counts how many allocations have been made with it, and with any type (see Counts)
+template <typename T>
+struct CountingAllocator : std::allocator<T> {
+    static inline std::size_t allocations = 0;
+
+    CountingAllocator() = default;
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U>&) {}
+
+    T* allocate(std::size_t n) {
+        allocations++;
+        Counts::allocations++;
+        Counts::outstanding++;
+        return std::allocator<T>::allocate(n);
+    }
+    void deallocate(T* p, std::size_t n) {
+        Counts::outstanding--;
+        std::allocator<T>::deallocate(p, n);
+    }
+};
+
+#endif
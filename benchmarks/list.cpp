@@ -0,0 +1,137 @@
+#include <cstddef>
+
+#include <algorithm>
+#include <list>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include <codlili/list.hpp>
+#include <codlili/node_pool_allocator.hpp>
+
+#include "helpers.hpp"
+
+
+using namespace com::saxbophone::codlili;
+
+namespace {
+    // keeps about occupancy elements in the list while pushing and popping at both ends count times
+    template <class List>
+    void churn(List& elements, std::size_t occupancy, std::size_t count) {
+        for (std::size_t i = 0; i < count; i++) {
+            if (i % 2 == 0) {
+                elements.push_back((int)i);
+            } else {
+                elements.push_front((int)i);
+            }
+            if (elements.size() > occupancy) {
+                if (i % 3 == 0) {
+                    elements.pop_front();
+                } else {
+                    elements.pop_back();
+                }
+            }
+        }
+    }
+
+    template <class List>
+    std::size_t allocations_for_churn(std::size_t occupancy, std::size_t count) {
+        std::size_t before = Counts::allocations;
+        {
+            List elements;
+            churn(elements, occupancy, count);
+        }
+        return Counts::allocations - before;
+    }
+
+    template <class List>
+    List scrambled(std::size_t size) {
+        List elements;
+        unsigned state = 12345;
+        for (std::size_t i = 0; i < size; i++) {
+            state = state * 1103515245 + 12345;
+            elements.push_back((int)(state >> 8));
+        }
+        return elements;
+    }
+
+    // what sorting a list took before it had sort(): copying into a vector, sorting that and rebuilding the list
+    void sort_by_copying(list<int>& elements) {
+        std::vector<int> values(elements.begin(), elements.end());
+        std::sort(values.begin(), values.end());
+        elements.clear();
+        for (int value : values) {
+            elements.push_back(value);
+        }
+    }
+
+    template <class List>
+    long long sum(const List& elements) {
+        long long total = 0;
+        for (int element : elements) {
+            total += element;
+        }
+        return total;
+    }
+}
+
+TEST_CASE("list with node_pool_allocator compared to std::list", "[!benchmark]") {
+    std::size_t occupancy = (std::size_t)GENERATE(1000, 100000, 1000000);
+    const std::size_t count = 1 << 22;
+
+    auto standard_allocations = allocations_for_churn<std::list<int, CountingAllocator<int>>>(occupancy, count);
+    auto plain_allocations = allocations_for_churn<list<int, CountingAllocator<int>>>(occupancy, count);
+    auto pooled_allocations = allocations_for_churn<
+        list<int, node_pool_allocator<int, 256, CountingAllocator<int>>>
+    >(occupancy, count);
+    WARN(
+        "upstream allocations while churning at occupancy " << occupancy
+        << ": std::list " << standard_allocations
+        << ", list " << plain_allocations
+        << ", list with node_pool_allocator " << pooled_allocations
+    );
+
+    BENCHMARK("std::list churn occupancy=" + std::to_string(occupancy)) {
+        std::list<int> elements;
+        churn(elements, occupancy, count);
+        return elements.size();
+    };
+    BENCHMARK("list with node_pool_allocator churn occupancy=" + std::to_string(occupancy)) {
+        list<int, node_pool_allocator<int>> elements;
+        churn(elements, occupancy, count);
+        return elements.size();
+    };
+
+    // nodes pushed at alternate ends and popped at random are scattered around the heap
+    std::list<int> standard;
+    churn(standard, occupancy, count);
+    list<int, node_pool_allocator<int>> pooled;
+    churn(pooled, occupancy, count);
+    REQUIRE(sum(standard) == sum(pooled));
+
+    BENCHMARK("std::list traversal after churn occupancy=" + std::to_string(occupancy)) {
+        return sum(standard);
+    };
+    BENCHMARK("list with node_pool_allocator traversal after churn occupancy=" + std::to_string(occupancy)) {
+        return sum(pooled);
+    };
+}
+
+TEST_CASE("list sort() compared to copying into a vector and std::list sort()", "[!benchmark]") {
+    std::size_t size = (std::size_t)GENERATE(1000, 100000, 1000000);
+
+    BENCHMARK_ADVANCED("list sort() size=" + std::to_string(size))(Catch::Benchmark::Chronometer meter) {
+        std::vector<list<int>> lists((std::size_t)meter.runs(), scrambled<list<int>>(size));
+        meter.measure([&](int i) { lists[(std::size_t)i].sort(); });
+    };
+    BENCHMARK_ADVANCED("list sorted by copying size=" + std::to_string(size))(Catch::Benchmark::Chronometer meter) {
+        std::vector<list<int>> lists((std::size_t)meter.runs(), scrambled<list<int>>(size));
+        meter.measure([&](int i) { sort_by_copying(lists[(std::size_t)i]); });
+    };
+    BENCHMARK_ADVANCED("std::list sort() size=" + std::to_string(size))(Catch::Benchmark::Chronometer meter) {
+        std::vector<std::list<int>> lists((std::size_t)meter.runs(), scrambled<std::list<int>>(size));
+        meter.measure([&](int i) { lists[(std::size_t)i].sort(); });
+    };
+}
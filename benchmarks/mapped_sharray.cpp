@@ -0,0 +1,56 @@
+#if defined(__unix__) or defined(__APPLE__)
+
+#include <cstddef>
+#include <cstdint>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include <catch2/catch_all.hpp>
+
+#include <codlili/mapped_sharray.hpp>
+#include <codlili/sharray.hpp>
+
+
+using namespace com::saxbophone::codlili;
+
+TEST_CASE("reloading a saved sharray compared to mapping it", "[!benchmark]") {
+    std::size_t size = (std::size_t)GENERATE(1 << 10, 1 << 24);
+    auto path = std::filesystem::temp_directory_path() / "codlili-benchmark.bin";
+    sharray<std::uint64_t> array;
+    for (std::size_t i = 0; i < size; i++) {
+        array.push_back(i);
+    }
+    save(array, path);
+
+    BENCHMARK("reading and pushing one at a time size=" + std::to_string(size)) {
+        std::ifstream file(path, std::ios::binary);
+        file.seekg((std::streamoff)sharray_file_header::describing<std::uint64_t>(size, 0).data_offset);
+        sharray<std::uint64_t> loaded;
+        std::uint64_t element;
+        while (file.read(reinterpret_cast<char*>(&element), sizeof(element))) {
+            loaded.push_back(element);
+        }
+        return loaded.size();
+    };
+    BENCHMARK("mapping size=" + std::to_string(size)) {
+        mapped_sharray<std::uint64_t> mapped(path);
+        return mapped.back();
+    };
+    BENCHMARK("mapping and reading every element size=" + std::to_string(size)) {
+        mapped_sharray<std::uint64_t> mapped(path);
+        std::uint64_t sum = 0;
+        for (std::uint64_t element : mapped) {
+            sum += element;
+        }
+        return sum;
+    };
+    BENCHMARK("mapping and copying into a sharray size=" + std::to_string(size)) {
+        mapped_sharray<std::uint64_t> mapped(path);
+        return sharray<std::uint64_t>(mapped.begin(), mapped.end()).size();
+    };
+    std::filesystem::remove(path);
+}
+
+#endif
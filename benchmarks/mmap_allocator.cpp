@@ -0,0 +1,74 @@
+#ifdef __linux__
+
+#include <cstddef>
+
+#include <string>
+
+#include <catch2/catch_all.hpp>
+
+#include <codlili/mmap_allocator.hpp>
+#include <codlili/sharray.hpp>
+
+
+using namespace com::saxbophone::codlili;
+
+namespace {
+    // grows an array one element at a time, at the front or the back
+    template <class Array>
+    std::size_t grow(std::size_t count, bool at_front) {
+        Array array;
+        for (std::size_t i = 0; i < count; i++) {
+            if (at_front) {
+                array.push_front((float)i);
+            } else {
+                array.push_back((float)i);
+            }
+        }
+        return array.size();
+    }
+
+    // sums every element, to compare scanning with and without huge pages
+    template <class Array>
+    float scan(const Array& array) {
+        float sum = 0;
+        for (float element : array) {
+            sum += element;
+        }
+        return sum;
+    }
+}
+
+TEST_CASE("growing large sharrays with mmap_allocator", "[!benchmark]") {
+    std::size_t count = (std::size_t)GENERATE(1 << 20, 1 << 25);
+    bool at_front = GENERATE(false, true);
+    std::string end = at_front ? " push_front()" : " push_back()";
+
+    BENCHMARK("std::allocator" + end + " size=" + std::to_string(count)) {
+        return grow<sharray<float>>(count, at_front);
+    };
+    BENCHMARK("mmap_allocator" + end + " size=" + std::to_string(count)) {
+        return grow<sharray<float, mmap_allocator<float>>>(count, at_front);
+    };
+    BENCHMARK("mmap_allocator with huge pages" + end + " size=" + std::to_string(count)) {
+        return grow<sharray<float, mmap_allocator<float, true>>>(count, at_front);
+    };
+}
+
+TEST_CASE("scanning large sharrays with and without huge pages", "[!benchmark]") {
+    const std::size_t count = 1 << 25;
+    sharray<float> plain(count, 1.0f);
+    sharray<float, mmap_allocator<float>> mapped(count, 1.0f);
+    sharray<float, mmap_allocator<float, true>> huge(count, 1.0f);
+
+    BENCHMARK("std::allocator size=" + std::to_string(count)) {
+        return scan(plain);
+    };
+    BENCHMARK("mmap_allocator size=" + std::to_string(count)) {
+        return scan(mapped);
+    };
+    BENCHMARK("mmap_allocator with huge pages size=" + std::to_string(count)) {
+        return scan(huge);
+    };
+}
+
+#endif
@@ -0,0 +1,95 @@
+#include <cstddef>
+
+#include <deque>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include <catch2/catch_all.hpp>
+
+#include <codlili/ring_sharray.hpp>
+#include <codlili/sharray.hpp>
+
+#include "helpers.hpp"
+
+
+using namespace com::saxbophone::codlili;
+
+namespace {
+    // pushes at the back and pops from the front count times, keeping occupancy elements queued
+    template <class Queue>
+    long long steady_queue(std::size_t occupancy, std::size_t count) {
+        Queue queue;
+        long long sum = 0;
+        for (std::size_t i = 0; i < count; i++) {
+            queue.push_back((int)i);
+            if (queue.size() > occupancy) {
+                sum += queue.front();
+                queue.pop_front();
+            }
+        }
+        return sum;
+    }
+
+    // int which counts how many times it's been moved
+    struct Counted {
+        static inline std::size_t moves = 0;
+
+        Counted(int value) : value(value) {}
+        Counted(const Counted&) = default;
+        Counted(Counted&& other) noexcept : value(other.value) { moves++; }
+        Counted& operator=(const Counted&) = default;
+        Counted& operator=(Counted&& other) noexcept { value = other.value; moves++; return *this; }
+
+        int value;
+    };
+
+    // how many allocations and element moves steady_queue() makes after it's first reached its occupancy
+    template <template <typename, typename> class Queue>
+    std::pair<std::size_t, std::size_t> churn_once_warm(std::size_t occupancy, std::size_t count) {
+        Queue<Counted, CountingAllocator<Counted>> queue;
+        std::size_t allocations = 0;
+        std::size_t moves = 0;
+        for (std::size_t i = 0; i < count; i++) {
+            queue.push_back((int)i);
+            if (queue.size() > occupancy) {
+                queue.pop_front();
+            }
+            if (i == occupancy) {
+                allocations = CountingAllocator<Counted>::allocations;
+                moves = Counted::moves;
+            }
+        }
+        return {CountingAllocator<Counted>::allocations - allocations, Counted::moves - moves};
+    }
+
+    template <typename T, typename Allocator>
+    using plain_sharray = sharray<T, Allocator>;
+    template <typename T, typename Allocator>
+    using plain_ring_sharray = ring_sharray<T, Allocator>;
+}
+
+TEST_CASE("ring_sharray compared to sharray and deque as a FIFO queue", "[!benchmark]") {
+    std::size_t occupancy = (std::size_t)GENERATE(16, 4096, 1 << 20);
+    const std::size_t count = 1 << 22;
+
+    auto plain = churn_once_warm<plain_sharray>(occupancy, count);
+    auto ring = churn_once_warm<plain_ring_sharray>(occupancy, count);
+    auto deque = churn_once_warm<std::deque>(occupancy, count);
+    WARN(
+        "allocations and element moves once warm at occupancy " << occupancy
+        << ": sharray " << plain.first << " and " << plain.second
+        << ", ring_sharray " << ring.first << " and " << ring.second
+        << ", std::deque " << deque.first << " and " << deque.second
+    );
+
+    BENCHMARK("sharray queue occupancy=" + std::to_string(occupancy)) {
+        return steady_queue<sharray<int>>(occupancy, count);
+    };
+    BENCHMARK("ring_sharray queue occupancy=" + std::to_string(occupancy)) {
+        return steady_queue<ring_sharray<int>>(occupancy, count);
+    };
+    BENCHMARK("std::deque queue occupancy=" + std::to_string(occupancy)) {
+        return steady_queue<std::deque<int>>(occupancy, count);
+    };
+}
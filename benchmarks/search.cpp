@@ -0,0 +1,61 @@
+#include <cstddef>
+#include <cstdint>
+
+#include <string>
+
+#include <catch2/catch_all.hpp>
+
+#include <codlili/search.hpp>
+#include <codlili/sharray.hpp>
+
+
+using namespace com::saxbophone::codlili;
+
+namespace {
+    // benchmarks find() and count() of the last element with each instruction set the CPU supports
+    template <typename T>
+    void benchmark_search(const std::string& type, std::size_t size) {
+        sharray<T> array(size, T(1));
+        array.back() = T(2);
+        auto best = detail::detect_simd_level();
+        const std::pair<detail::simd_level, const char*> levels[] = {
+            {detail::simd_level::SCALAR, "scalar"},
+            {detail::simd_level::SSE2, "SSE2"},
+            {detail::simd_level::AVX2, "AVX2"},
+        };
+        for (auto [level, name] : levels) {
+            if (level > best) { break; }
+            BENCHMARK("find() " + type + " " + name + " size=" + std::to_string(size)) {
+                return detail::find(level, array.data(), array.size(), T(2));
+            };
+            BENCHMARK("count() " + type + " " + name + " size=" + std::to_string(size)) {
+                return detail::count(level, array.data(), array.size(), T(2));
+            };
+        }
+    }
+}
+
+TEST_CASE("sharray search with and without SIMD", "[!benchmark]") {
+    std::size_t size = (std::size_t)GENERATE(64, 4096, 1 << 20);
+
+    benchmark_search<char>("char", size);
+    benchmark_search<std::int16_t>("int16_t", size);
+    benchmark_search<int>("int", size);
+    benchmark_search<std::int64_t>("int64_t", size);
+}
+
+TEST_CASE("sharray equality with and without memcmp", "[!benchmark]") {
+    std::size_t size = (std::size_t)GENERATE(64, 4096, 1 << 20);
+    sharray<int> array(size, 42);
+    sharray<int> other(size, 42);
+
+    BENCHMARK("operator== (memcmp) size=" + std::to_string(size)) {
+        return array == other;
+    };
+    BENCHMARK("element-wise loop size=" + std::to_string(size)) {
+        for (std::size_t i = 0; i < size; i++) {
+            if (array[i] != other[i]) { return false; }
+        }
+        return true;
+    };
+}
@@ -0,0 +1,95 @@
+#include <cstddef>
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <string>
+
+#include <catch2/catch_all.hpp>
+
+#include <codlili/segmented_sharray.hpp>
+#include <codlili/sharray.hpp>
+
+
+using namespace com::saxbophone::codlili;
+
+namespace {
+    // pushes count elements, alternating between the back and the front
+    template <class Array>
+    std::size_t push_both_ends(std::size_t count) {
+        Array array;
+        for (std::size_t i = 0; i < count; i++) {
+            if (i % 2 == 0) {
+                array.push_back((int)i);
+            } else {
+                array.push_front((int)i);
+            }
+        }
+        return array.size();
+    }
+
+    // the longest any single push_back() takes while growing to count elements
+    template <class Array>
+    std::chrono::nanoseconds worst_push(std::size_t count) {
+        Array array;
+        std::chrono::nanoseconds worst{0};
+        for (std::size_t i = 0; i < count; i++) {
+            auto start = std::chrono::steady_clock::now();
+            array.push_back((int)i);
+            worst = std::max(worst, std::chrono::steady_clock::now() - start);
+        }
+        return worst;
+    }
+
+    // sums the elements at count pseudo-random indices
+    template <class Array>
+    long long random_access(const Array& array, std::size_t count) {
+        long long sum = 0;
+        std::size_t index = 0;
+        for (std::size_t i = 0; i < count; i++) {
+            index = (index * 1103515245 + 12345) % array.size();
+            sum += array[index];
+        }
+        return sum;
+    }
+}
+
+TEST_CASE("segmented_sharray compared to sharray and deque", "[!benchmark]") {
+    std::size_t size = (std::size_t)GENERATE(1 << 16, 1 << 24);
+
+    WARN(
+        "worst single push_back() growing to " << size << " elements: sharray "
+        << worst_push<sharray<int>>(size).count() << "ns, segmented_sharray "
+        << worst_push<segmented_sharray<int>>(size).count() << "ns, std::deque "
+        << worst_push<std::deque<int>>(size).count() << "ns"
+    );
+
+    BENCHMARK("sharray push at both ends size=" + std::to_string(size)) {
+        return push_both_ends<sharray<int>>(size);
+    };
+    BENCHMARK("segmented_sharray push at both ends size=" + std::to_string(size)) {
+        return push_both_ends<segmented_sharray<int>>(size);
+    };
+    BENCHMARK("std::deque push at both ends size=" + std::to_string(size)) {
+        return push_both_ends<std::deque<int>>(size);
+    };
+
+    sharray<int> plain(size, 1);
+    segmented_sharray<int> segmented(size, 1);
+    std::deque<int> deque(size, 1);
+    BENCHMARK("sharray random access size=" + std::to_string(size)) {
+        return random_access(plain, 1 << 16);
+    };
+    BENCHMARK("segmented_sharray random access size=" + std::to_string(size)) {
+        return random_access(segmented, 1 << 16);
+    };
+    BENCHMARK("std::deque random access size=" + std::to_string(size)) {
+        return random_access(deque, 1 << 16);
+    };
+    BENCHMARK("sharray find() size=" + std::to_string(size)) {
+        return plain.find(2) == plain.end();
+    };
+    BENCHMARK("segmented_sharray find() size=" + std::to_string(size)) {
+        return segmented.find(2) == segmented.end();
+    };
+}
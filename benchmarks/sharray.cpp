@@ -0,0 +1,179 @@
+#include <cstddef>
+#include <cstring>
+
+#include <array>
+#include <deque>
+#include <memory_resource>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include <codlili/sharray.hpp>
+
+
+using namespace com::saxbophone::codlili;
+
+namespace {
+    // a string which can't be moved without risk of throwing, so gets deep-copied on reallocation
+    struct CopiedString {
+        CopiedString(const std::string& value = {}) : value(value) {}
+        CopiedString(const CopiedString& other) = default;
+        CopiedString(CopiedString&& other) noexcept(false) : value(std::move(other.value)) {}
+
+        std::string value;
+    };
+
+    // a heap-allocated payload long enough to defeat the small string optimisation
+    const std::string PAYLOAD(64, 'x');
+
+    // benchmarks a single .reserve() which doubles the capacity of a full sharray
+    template <typename T>
+    void benchmark_reserve(Catch::Benchmark::Chronometer meter, std::size_t size, const T& value) {
+        std::vector<sharray<T>> arrays(
+            (std::size_t)meter.runs(), sharray<T>(size, value)
+        );
+        meter.measure([&](int i) { arrays[(std::size_t)i].reserve(size * 2); });
+    }
+
+    // inserts and then erases elements at pseudo-random positions in a container of the given size
+    template <class Container>
+    std::size_t random_edits(std::size_t size, std::size_t edits) {
+        Container container(size, 42);
+        std::minstd_rand positions(0);
+        for (std::size_t i = 0; i < edits; i++) {
+            auto offset = (typename Container::difference_type)(positions() % (container.size() + 1));
+            container.insert(container.begin() + offset, (int)i);
+        }
+        for (std::size_t i = 0; i < edits; i++) {
+            auto offset = (typename Container::difference_type)(positions() % container.size());
+            container.erase(container.begin() + offset);
+        }
+        return container.size();
+    }
+
+    // simulates handling a request, which builds a few short-lived buffers using the given allocator
+    template <class Array, class Allocator>
+    std::size_t handle_request(const Allocator& allocator) {
+        std::size_t total = 0;
+        for (int buffer = 0; buffer < 8; buffer++) {
+            Array array(allocator);
+            for (int i = 0; i < 100; i++) {
+                array.push_back(i);
+                array.push_front(-i);
+            }
+            total += array.size();
+        }
+        return total;
+    }
+}
+
+TEST_CASE("sharray growth cost when reallocating", "[!benchmark]") {
+    std::size_t size = (std::size_t)GENERATE(1000, 100000);
+
+    BENCHMARK_ADVANCED("reserve() sharray<int> (memcpy) size=" + std::to_string(size))(Catch::Benchmark::Chronometer meter) {
+        benchmark_reserve<int>(meter, size, 42);
+    };
+    BENCHMARK_ADVANCED("reserve() sharray<std::string> (move) size=" + std::to_string(size))(Catch::Benchmark::Chronometer meter) {
+        benchmark_reserve<std::string>(meter, size, PAYLOAD);
+    };
+    BENCHMARK_ADVANCED("reserve() sharray<CopiedString> (deep copy) size=" + std::to_string(size))(Catch::Benchmark::Chronometer meter) {
+        benchmark_reserve<CopiedString>(meter, size, CopiedString(PAYLOAD));
+    };
+    BENCHMARK("push_back() sharray<std::string> size=" + std::to_string(size)) {
+        sharray<std::string> array;
+        for (std::size_t i = 0; i < size; i++) {
+            array.push_back(PAYLOAD);
+        }
+        return array.size();
+    };
+    BENCHMARK("push_back() sharray<CopiedString> size=" + std::to_string(size)) {
+        sharray<CopiedString> array;
+        for (std::size_t i = 0; i < size; i++) {
+            array.push_back(CopiedString(PAYLOAD));
+        }
+        return array.size();
+    };
+}
+
+TEST_CASE("sharray random-position insert and erase", "[!benchmark]") {
+    std::size_t size = (std::size_t)GENERATE(1000, 100000);
+    const std::size_t edits = 1000;
+
+    BENCHMARK("sharray<int> size=" + std::to_string(size)) {
+        return random_edits<sharray<int>>(size, edits);
+    };
+    BENCHMARK("std::vector<int> size=" + std::to_string(size)) {
+        return random_edits<std::vector<int>>(size, edits);
+    };
+    BENCHMARK("std::deque<int> size=" + std::to_string(size)) {
+        return random_edits<std::deque<int>>(size, edits);
+    };
+}
+
+TEST_CASE("sharray per-request arena allocation", "[!benchmark]") {
+    BENCHMARK("sharray<int> with std::allocator") {
+        return handle_request<sharray<int>>(std::allocator<int>());
+    };
+    BENCHMARK("pmr::sharray<int> with a monotonic arena") {
+        // arena is released in one go at the end of the request
+        std::pmr::monotonic_buffer_resource arena;
+        return handle_request<pmr::sharray<int>>(std::pmr::polymorphic_allocator<int>(&arena));
+    };
+    BENCHMARK("pmr::sharray<int> with a monotonic arena in a stack buffer") {
+        std::array<std::byte, 64 * 1024> buffer;
+        std::pmr::monotonic_buffer_resource arena(
+            buffer.data(), buffer.size(), std::pmr::null_memory_resource()
+        );
+        return handle_request<pmr::sharray<int>>(std::pmr::polymorphic_allocator<int>(&arena));
+    };
+}
+
+TEST_CASE("sharray filling a buffer from bulk input", "[!benchmark]") {
+    const std::size_t size = 1 << 20;
+    const std::vector<std::byte> input(size, std::byte(42));
+
+    BENCHMARK("resize() then overwrite") {
+        sharray<std::byte> buffer;
+        buffer.resize(size);
+        std::memcpy(buffer.begin(), input.data(), size);
+        return buffer.size();
+    };
+    BENCHMARK("resize_for_overwrite() then overwrite") {
+        sharray<std::byte> buffer;
+        buffer.resize_for_overwrite(size);
+        std::memcpy(buffer.begin(), input.data(), size);
+        return buffer.size();
+    };
+    BENCHMARK("append_uninitialized() then overwrite") {
+        sharray<std::byte> buffer;
+        std::span<std::byte> destination = buffer.append_uninitialized(size);
+        std::memcpy(destination.data(), input.data(), size);
+        return buffer.size();
+    };
+}
+
+TEST_CASE("sharray prepending a batch of elements", "[!benchmark]") {
+    std::size_t size = (std::size_t)GENERATE(1000, 100000);
+    const std::vector<int> batch(size, 42);
+
+    BENCHMARK("push_front() each element size=" + std::to_string(size)) {
+        sharray<int> array = {1, 2, 3};
+        for (auto it = batch.rbegin(); it != batch.rend(); ++it) {
+            array.push_front(*it);
+        }
+        return array.size();
+    };
+    BENCHMARK("prepend_range() size=" + std::to_string(size)) {
+        sharray<int> array = {1, 2, 3};
+        array.prepend_range(batch);
+        return array.size();
+    };
+    BENCHMARK("std::vector<int>::insert() at the front size=" + std::to_string(size)) {
+        std::vector<int> array = {1, 2, 3};
+        array.insert(array.begin(), batch.begin(), batch.end());
+        return array.size();
+    };
+}
@@ -0,0 +1,86 @@
+#include <cstddef>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include <codlili/small_sharray.hpp>
+
+#include "helpers.hpp"
+
+
+using namespace com::saxbophone::codlili;
+
+namespace {
+    // builds many short-lived arrays of the given size, pushing at both ends
+    template <class Array>
+    std::size_t build_arrays(std::size_t count, std::size_t size) {
+        std::size_t total = 0;
+        for (std::size_t i = 0; i < count; i++) {
+            Array array;
+            for (std::size_t j = 0; j < size; j++) {
+                if (j % 2 == 0) {
+                    array.push_back((int)j);
+                } else {
+                    array.push_front((int)j);
+                }
+            }
+            total += array.size();
+        }
+        return total;
+    }
+
+    // how many allocations building arrays with build_arrays() makes
+    template <template <typename> class Array>
+    std::size_t allocations_made(std::size_t count, std::size_t size) {
+        CountingAllocator<int>::allocations = 0;
+        build_arrays<Array<CountingAllocator<int>>>(count, size);
+        return CountingAllocator<int>::allocations;
+    }
+
+    template <class Allocator>
+    using plain = sharray<int, Allocator>;
+
+    template <class Allocator>
+    using small = small_sharray<int, 16, Allocator>;
+}
+
+TEST_CASE("small_sharray allocations compared to sharray") {
+    const std::size_t count = 1000;
+    std::size_t size = (std::size_t)GENERATE(4, 16, 64);
+
+    std::size_t plain_allocations = allocations_made<plain>(count, size);
+    std::size_t small_allocations = allocations_made<small>(count, size);
+    UNSCOPED_INFO("arrays of size " << size << ": sharray made " << plain_allocations
+        << " allocations, small_sharray<int, 16> made " << small_allocations);
+    if (size <= 16) {
+        CHECK(small_allocations == 0);
+    } else {
+        CHECK(small_allocations < plain_allocations);
+    }
+}
+
+TEST_CASE("small_sharray construction cost compared to sharray", "[!benchmark]") {
+    const std::size_t count = 1000;
+    std::size_t size = (std::size_t)GENERATE(4, 16, 64);
+
+    BENCHMARK("sharray<int> size=" + std::to_string(size)) {
+        return build_arrays<sharray<int>>(count, size);
+    };
+    BENCHMARK("small_sharray<int, 16> size=" + std::to_string(size)) {
+        return build_arrays<small_sharray<int, 16>>(count, size);
+    };
+    BENCHMARK("std::vector<int> size=" + std::to_string(size)) {
+        std::size_t total = 0;
+        for (std::size_t i = 0; i < count; i++) {
+            std::vector<int> array;
+            for (std::size_t j = 0; j < size; j++) {
+                array.push_back((int)j);
+            }
+            total += array.size();
+        }
+        return total;
+    };
+}
@@ -0,0 +1,95 @@
+#include <cstddef>
+
+#include <list>
+#include <string>
+
+#include <catch2/catch_all.hpp>
+
+#include <codlili/list.hpp>
+#include <codlili/unrolled_list.hpp>
+
+
+using namespace com::saxbophone::codlili;
+
+namespace {
+    template <class List>
+    List filled(std::size_t size) {
+        List elements;
+        for (std::size_t i = 0; i < size; i++) {
+            elements.push_back((int)i);
+        }
+        return elements;
+    }
+
+    template <class List>
+    long long sum(const List& elements) {
+        long long total = 0;
+        for (int element : elements) {
+            total += element;
+        }
+        return total;
+    }
+
+    // inserts an element before every existing one, walking the list with an iterator
+    template <class List>
+    std::size_t insert_between(std::size_t size) {
+        List elements = filled<List>(size);
+        for (auto it = elements.begin(); it != elements.end(); ++it) {
+            it = elements.insert(it, -1);
+            ++it;
+        }
+        return elements.size();
+    }
+
+    // codlili::list has no insert(), so the same is done by rebuilding it with pushes
+    template <>
+    std::size_t insert_between<list<int>>(std::size_t size) {
+        list<int> elements = filled<list<int>>(size);
+        list<int> result;
+        for (int element : elements) {
+            result.push_back(-1);
+            result.push_back(element);
+        }
+        return result.size();
+    }
+}
+
+TEST_CASE("unrolled_list compared to list and std::list", "[!benchmark]") {
+    std::size_t size = (std::size_t)GENERATE(1000, 100000, 1000000);
+
+    auto unrolled = filled<unrolled_list<int>>(size);
+    auto linked = filled<list<int>>(size);
+    auto standard = filled<std::list<int>>(size);
+    REQUIRE(sum(unrolled) == sum(standard));
+    REQUIRE(sum(linked) == sum(standard));
+
+    BENCHMARK("unrolled_list traversal size=" + std::to_string(size)) {
+        return sum(unrolled);
+    };
+    BENCHMARK("list traversal size=" + std::to_string(size)) {
+        return sum(linked);
+    };
+    BENCHMARK("std::list traversal size=" + std::to_string(size)) {
+        return sum(standard);
+    };
+
+    BENCHMARK("unrolled_list push_back size=" + std::to_string(size)) {
+        return filled<unrolled_list<int>>(size).size();
+    };
+    BENCHMARK("list push_back size=" + std::to_string(size)) {
+        return filled<list<int>>(size).size();
+    };
+    BENCHMARK("std::list push_back size=" + std::to_string(size)) {
+        return filled<std::list<int>>(size).size();
+    };
+
+    BENCHMARK("unrolled_list insert between size=" + std::to_string(size)) {
+        return insert_between<unrolled_list<int>>(size);
+    };
+    BENCHMARK("list rebuild between size=" + std::to_string(size)) {
+        return insert_between<list<int>>(size);
+    };
+    BENCHMARK("std::list insert between size=" + std::to_string(size)) {
+        return insert_between<std::list<int>>(size);
+    };
+}
@@ -0,0 +1,540 @@
+/*
+ * Created by Joshua Saxby <joshua.a.saxby@gmail.com>, October 2026
+ * Copyright Joshua Saxby <joshua.a.saxby@gmail.com> 2026
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef COM_SAXBOPHONE_CODLILI_BIT_SHARRAY_HPP
+#define COM_SAXBOPHONE_CODLILI_BIT_SHARRAY_HPP
+
+#include <cstddef>          // ptrdiff_t, size_t
+#include <cstdint>          // uint64_t
+
+#include <algorithm>        // lexicographical_compare_three_way
+#include <bit>              // countr_zero
+#include <initializer_list> // initializer_list
+#include <iterator>         // forward_iterator, input_iterator, random_access_iterator_tag, reverse_iterator
+#include <limits>           // numeric_limits
+#include <memory>           // allocator, allocator_traits
+#include <stdexcept>        // invalid_argument, out_of_range
+#include <type_traits>      // conditional_t
+#include <utility>          // exchange, move, pair, swap
+
+#include <codlili/growth_policy.hpp>
+#include <codlili/search.hpp>
+#include <codlili/sharray.hpp>
+
+
+namespace com::saxbophone::codlili {
+    namespace detail {
+        // proxy for a single bit within a word, as returned by bit_sharray's non-const element access
+        class bit_reference {
+        public:
+            constexpr bit_reference(std::uint64_t* word, std::uint64_t mask) noexcept
+              : _word(word)
+              , _mask(mask)
+              {}
+            constexpr bit_reference(const bit_reference&) = default;
+
+            constexpr operator bool() const noexcept { return (*_word & _mask) != 0; }
+            constexpr bool operator~() const noexcept { return not *this; }
+            constexpr bit_reference& operator=(bool value) noexcept {
+                if (value) {
+                    *_word |= _mask;
+                } else {
+                    *_word &= ~_mask;
+                }
+                return *this;
+            }
+            // assigns the bit referred to, not which bit is referred to
+            constexpr bit_reference& operator=(const bit_reference& other) noexcept {
+                return *this = static_cast<bool>(other);
+            }
+            constexpr void flip() noexcept { *_word ^= _mask; }
+
+            friend constexpr void swap(bit_reference lhs, bit_reference rhs) noexcept {
+                bool value = lhs;
+                lhs = static_cast<bool>(rhs);
+                rhs = value;
+            }
+        private:
+            std::uint64_t* _word;
+            std::uint64_t _mask;
+        };
+
+        // iterator of bit_sharray, which refers to a bit by its position from the start of the first word
+        template <bool Const>
+        class bit_iterator {
+        public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = bool;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = std::conditional_t<Const, bool, bit_reference>;
+
+            constexpr bit_iterator() = default;
+            constexpr bit_iterator(std::uint64_t* words, std::size_t position)
+              : _words(words)
+              , _position(position)
+              {}
+            constexpr bit_iterator(const bit_iterator&) = default;
+            constexpr bit_iterator& operator=(const bit_iterator&) = default;
+            // iterator converts to const_iterator
+            constexpr bit_iterator(const bit_iterator<false>& other) requires Const
+              : _words(other._words)
+              , _position(other._position)
+              {}
+
+            constexpr reference operator*() const {
+                if constexpr (Const) {
+                    return (_words[_position / 64] >> (_position % 64) & 1) != 0;
+                } else {
+                    return {_words + _position / 64, std::uint64_t(1) << (_position % 64)};
+                }
+            }
+            constexpr reference operator[](difference_type n) const { return *(*this + n); }
+
+            constexpr bit_iterator& operator++() { _position++; return *this; }
+            constexpr bit_iterator operator++(int) { auto old = *this; ++*this; return old; }
+            constexpr bit_iterator& operator--() { _position--; return *this; }
+            constexpr bit_iterator operator--(int) { auto old = *this; --*this; return old; }
+            // unsigned arithmetic wraps around, so adding a negative offset works too
+            constexpr bit_iterator& operator+=(difference_type n) {
+                _position += static_cast<std::size_t>(n);
+                return *this;
+            }
+            constexpr bit_iterator& operator-=(difference_type n) {
+                _position -= static_cast<std::size_t>(n);
+                return *this;
+            }
+            friend constexpr bit_iterator operator+(bit_iterator it, difference_type n) { return it += n; }
+            friend constexpr bit_iterator operator+(difference_type n, bit_iterator it) { return it += n; }
+            friend constexpr bit_iterator operator-(bit_iterator it, difference_type n) { return it -= n; }
+            friend constexpr difference_type operator-(const bit_iterator& lhs, const bit_iterator& rhs) {
+                return static_cast<difference_type>(lhs._position - rhs._position);
+            }
+            friend constexpr bool operator==(const bit_iterator& lhs, const bit_iterator& rhs) {
+                return lhs._position == rhs._position;
+            }
+            friend constexpr auto operator<=>(const bit_iterator& lhs, const bit_iterator& rhs) {
+                return lhs._position <=> rhs._position;
+            }
+        private:
+            template <bool>
+            friend class bit_iterator;
+
+            std::uint64_t* _words = nullptr;
+            std::size_t _position = 0;
+        };
+    }
+
+    /**
+     * @brief A sharray of bools packed into 64-bit words, one bit each
+     * @details bit_sharray grows at both ends like sharray does, and keeps
+     * the same headroom at each end, by storing its words in a sharray.
+     * Bits are pushed into the spare bits of the first or last word, and a
+     * new word is only pushed once those run out, so pushing at the front
+     * never shifts any bits along until the word sharray itself runs out of
+     * room at the front.
+     * Counting, searching, comparing and the bitwise operators work on whole
+     * words at a time, using popcount and count-trailing-zeroes.
+     * @note This is a separate type rather than a specialisation of
+     * `sharray<bool>`, which remains a contiguous array of real bools.
+     * Like `std::vector<bool>`, elements can't be referred to directly, so
+     * non-const element access returns proxy objects rather than `bool&`.
+     * @note Bits can only be inserted and removed at the ends.
+     * @tparam Allocator the allocator to use for the words
+     * @tparam GrowthPolicy decides how many words to allocate when full
+     */
+    template <
+        class Allocator = std::allocator<std::uint64_t>,
+        growth_policy GrowthPolicy = default_growth
+    >
+    class bit_sharray {
+    private:
+        using WordAllocator = std::allocator_traits<Allocator>::template rebind_alloc<std::uint64_t>;
+    public:
+        using value_type = bool;
+        using allocator_type = Allocator;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using word_type = std::uint64_t;
+        using reference = detail::bit_reference;
+        using const_reference = bool;
+        using iterator = detail::bit_iterator<false>;
+        using const_iterator = detail::bit_iterator<true>;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+        static constexpr size_type word_bits = 64;
+        // member functions
+        constexpr bit_sharray() noexcept(noexcept(Allocator())) {}
+        constexpr explicit bit_sharray(const Allocator& alloc) noexcept
+          : _words(WordAllocator(alloc))
+          {}
+
+        constexpr bit_sharray(
+            size_type count,
+            bool value,
+            const Allocator& alloc = Allocator()
+        )
+          : bit_sharray(alloc)
+          {
+            resize(count, value);
+        }
+
+        constexpr explicit bit_sharray(
+            size_type count, const Allocator& alloc = Allocator()
+        )
+          : bit_sharray(count, false, alloc) {}
+
+        template<std::input_iterator InputIt>
+        constexpr bit_sharray(
+            InputIt first, InputIt last, const Allocator& alloc = Allocator()
+        )
+          : bit_sharray(alloc)
+          {
+            if constexpr (std::forward_iterator<InputIt>) {
+                reserve(static_cast<size_type>(std::distance(first, last)));
+            }
+            for (; first != last; ++first) {
+                push_back(static_cast<bool>(*first));
+            }
+        }
+
+        constexpr bit_sharray(
+            std::initializer_list<bool> init, const Allocator& alloc = Allocator()
+        )
+          : bit_sharray(init.begin(), init.end(), alloc)
+          {}
+
+        constexpr bit_sharray(const bit_sharray& other) = default;
+
+        constexpr bit_sharray(bit_sharray&& other) noexcept
+          : _words(std::move(other._words))
+          , _first(std::exchange(other._first, 0))
+          , _size(std::exchange(other._size, 0))
+          {}
+
+        constexpr bit_sharray& operator=(const bit_sharray& other) = default;
+        constexpr bit_sharray& operator=(bit_sharray&& other) noexcept(
+            noexcept(_words = std::move(other._words))
+        ) {
+            if (this == &other) { return *this; }
+            _words = std::move(other._words);
+            _first = std::exchange(other._first, 0);
+            _size = std::exchange(other._size, 0);
+            return *this;
+        }
+        constexpr bit_sharray& operator=(std::initializer_list<bool> ilist) {
+            *this = bit_sharray(ilist, get_allocator());
+            return *this;
+        }
+        constexpr allocator_type get_allocator() const noexcept {
+            return allocator_type(_words.get_allocator());
+        }
+        // element access
+        constexpr reference at(size_type pos) {
+            _check_index(pos);
+            return (*this)[pos];
+        }
+        constexpr const_reference at(size_type pos) const {
+            _check_index(pos);
+            return (*this)[pos];
+        }
+        constexpr reference operator[](size_type pos) {
+            size_type position = _first + pos;
+            return {&_words[position / word_bits], _bit(position)};
+        }
+        constexpr const_reference operator[](size_type pos) const {
+            size_type position = _first + pos;
+            return (_words[position / word_bits] & _bit(position)) != 0;
+        }
+        constexpr reference front() { return (*this)[0]; }
+        constexpr const_reference front() const { return (*this)[0]; }
+        constexpr reference back() { return (*this)[_size - 1]; }
+        constexpr const_reference back() const { return (*this)[_size - 1]; }
+        // iterators
+        constexpr iterator begin() noexcept { return {_words.data(), _first}; }
+        constexpr const_iterator begin() const noexcept { return {_data(), _first}; }
+        constexpr const_iterator cbegin() const noexcept { return begin(); }
+        constexpr iterator end() noexcept { return {_words.data(), _first + _size}; }
+        constexpr const_iterator end() const noexcept { return {_data(), _first + _size}; }
+        constexpr const_iterator cend() const noexcept { return end(); }
+        constexpr reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+        constexpr const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+        constexpr const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+        constexpr reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+        constexpr const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+        constexpr const_reverse_iterator crend() const noexcept { return rend(); }
+        // capacity
+        [[nodiscard]] constexpr bool empty() const noexcept { return _size == 0; }
+        constexpr size_type size() const noexcept { return _size; }
+        constexpr size_type max_size() const noexcept {
+            return std::numeric_limits<difference_type>::max();
+        }
+        constexpr void reserve(size_type new_cap) {
+            _words.reserve(_words_for(new_cap));
+        }
+        // pair of sizes for cap denotes bits to reserve before and after front
+        constexpr void reserve(std::pair<size_type, size_type> bidir_cap) {
+            auto [behind, ahead] = bidir_cap;
+            // _first bits before the front are already in the first word
+            size_type words_behind = behind > _first ? _words_for(behind - _first) : 0;
+            _words.reserve({words_behind, _words_for(_first + ahead)});
+        }
+        constexpr size_type capacity() const noexcept { return _words.capacity() * word_bits; }
+        constexpr void shrink_to_fit() {
+            _words.shrink_to_fit();
+        }
+        // modifiers
+        constexpr void clear() noexcept {
+            _words.clear();
+            _first = 0;
+            _size = 0;
+        }
+        constexpr void push_back(bool value) {
+            if (_first + _size == _words.size() * word_bits) {
+                _words.push_back(0);
+            }
+            _set(_first + _size, value);
+            _size++;
+        }
+        constexpr void pop_back() {
+            _size--;
+            _set(_first + _size, false);
+            if (_size == 0) {
+                clear();
+            } else if (_first + _size <= (_words.size() - 1) * word_bits) {
+                _words.pop_back();
+            }
+        }
+        constexpr void push_front(bool value) {
+            if (_first == 0) {
+                _words.push_front(0);
+                _first = word_bits;
+            }
+            _first--;
+            _set(_first, value);
+            _size++;
+        }
+        constexpr void pop_front() {
+            _set(_first, false);
+            _first++;
+            _size--;
+            if (_size == 0) {
+                clear();
+            } else if (_first == word_bits) {
+                _words.pop_front();
+                _first = 0;
+            }
+        }
+        constexpr void resize(size_type count, bool value = false) {
+            if (count == 0) { return clear(); }
+            size_type old_end = _first + _size;
+            size_type new_end = _first + count;
+            size_type old_words = _words.size();
+            // whole new words are filled in one go, then the rest a bit at a time
+            _words.resize(_words_for(new_end), value ? ~word_type(0) : 0);
+            if (count > _size) {
+                for (size_type position = old_end; position < new_end and position < old_words * word_bits; position++) {
+                    _set(position, value);
+                }
+            }
+            _size = count;
+            _clear_outside();
+        }
+        constexpr void swap(bit_sharray& other) noexcept(noexcept(_words.swap(other._words))) {
+            _words.swap(other._words);
+            std::swap(_first, other._first);
+            std::swap(_size, other._size);
+        }
+        // bit operations
+        constexpr void flip(size_type pos) {
+            (*this)[pos].flip();
+        }
+        constexpr void flip() noexcept {
+            for (word_type& word : _words) {
+                word = ~word;
+            }
+            _clear_outside();
+        }
+        // these combine bits at the same index, and throw std::invalid_argument if the sizes differ
+        constexpr bit_sharray& operator&=(const bit_sharray& other) {
+            _combine(other, [](word_type& word, word_type bits) { word &= bits; });
+            return *this;
+        }
+        constexpr bit_sharray& operator|=(const bit_sharray& other) {
+            _combine(other, [](word_type& word, word_type bits) { word |= bits; });
+            return *this;
+        }
+        constexpr bit_sharray& operator^=(const bit_sharray& other) {
+            _combine(other, [](word_type& word, word_type bits) { word ^= bits; });
+            return *this;
+        }
+        friend constexpr bit_sharray operator&(bit_sharray lhs, const bit_sharray& rhs) { return lhs &= rhs; }
+        friend constexpr bit_sharray operator|(bit_sharray lhs, const bit_sharray& rhs) { return lhs |= rhs; }
+        friend constexpr bit_sharray operator^(bit_sharray lhs, const bit_sharray& rhs) { return lhs ^= rhs; }
+        constexpr bit_sharray operator~() const {
+            bit_sharray flipped = *this;
+            flipped.flip();
+            return flipped;
+        }
+        // lookup
+        // the number of bits set
+        constexpr size_type count() const noexcept {
+            return detail::popcount(_words.data(), _words.size());
+        }
+        constexpr size_type count(bool value) const noexcept {
+            return value ? count() : _size - count();
+        }
+        // index of the first bit set, or size() if there isn't one
+        constexpr size_type find_first() const noexcept {
+            return _find_set_from(_first);
+        }
+        // index of the first bit set after the one at index prev, or size() if there isn't one
+        constexpr size_type find_next(size_type prev) const noexcept {
+            if (prev + 1 >= _size) { return _size; }
+            return _find_set_from(_first + prev + 1);
+        }
+        constexpr iterator find(bool value) {
+            return begin() + static_cast<difference_type>(_find(value));
+        }
+        constexpr const_iterator find(bool value) const {
+            return begin() + static_cast<difference_type>(_find(value));
+        }
+        constexpr bool contains(bool value) const noexcept {
+            return _find(value) != _size;
+        }
+        // comparison
+        constexpr bool operator==(const bit_sharray& other) const noexcept {
+            if (_size != other._size) { return false; }
+            for (size_type start = 0; start < _size; start += word_bits) {
+                auto offset = static_cast<difference_type>(start);
+                if (_bits_from(offset) != other._bits_from(offset)) { return false; }
+            }
+            return true;
+        }
+        constexpr auto operator<=>(const bit_sharray& other) const {
+            return std::lexicographical_compare_three_way(
+                begin(), end(), other.begin(), other.end()
+            );
+        }
+    private:
+        // the mask for the bit at position from the start of the first word
+        static constexpr word_type _bit(size_type position) {
+            return word_type(1) << (position % word_bits);
+        }
+        // how many words are needed to hold the given number of bits
+        static constexpr size_type _words_for(size_type bits) {
+            return (bits + word_bits - 1) / word_bits;
+        }
+        // the words, as iterators expect them (which never write through a const_iterator)
+        constexpr word_type* _data() const noexcept {
+            return const_cast<word_type*>(_words.data());
+        }
+        constexpr void _check_index(size_type pos) const {
+            if (pos >= _size) {
+                throw std::out_of_range("bit_sharray index out of range");
+            }
+        }
+        constexpr void _set(size_type position, bool value) {
+            word_type& word = _words[position / word_bits];
+            if (value) {
+                word |= _bit(position);
+            } else {
+                word &= ~_bit(position);
+            }
+        }
+        /*
+         * zeroes the bits in the first and last words outside the elements,
+         * which are always kept zero so that words can be counted and
+         * searched without masking
+         */
+        constexpr void _clear_outside() noexcept {
+            if (_words.empty()) { return; }
+            _words.front() &= ~word_type(0) << _first;
+            size_type end = (_first + _size) % word_bits;
+            if (end != 0) {
+                _words.back() &= ~(~word_type(0) << end);
+            }
+        }
+        // index of the first bit set at or after position from the start of the first word
+        constexpr size_type _find_set_from(size_type position) const noexcept {
+            size_type word_index = position / word_bits;
+            if (word_index >= _words.size()) { return _size; }
+            // ignore the bits before position in its word
+            word_type word = _words[word_index] & (~word_type(0) << (position % word_bits));
+            while (word == 0) {
+                if (++word_index == _words.size()) { return _size; }
+                word = _words[word_index];
+            }
+            return word_index * word_bits + static_cast<size_type>(std::countr_zero(word)) - _first;
+        }
+        // index of the first bit equal to value, or _size if there isn't one
+        constexpr size_type _find(bool value) const noexcept {
+            if (value) { return find_first(); }
+            // search for a set bit in each inverted word, minding the zeroes outside the elements
+            for (size_type start = 0; start < _size; start += word_bits) {
+                word_type unset = ~_bits_from(static_cast<difference_type>(start));
+                if (unset != 0) {
+                    size_type found = start + static_cast<size_type>(std::countr_zero(unset));
+                    return found < _size ? found : _size;
+                }
+            }
+            return _size;
+        }
+        // the word at index, or zero if it's beyond either end of the words
+        constexpr word_type _word_or_zero(difference_type index) const noexcept {
+            if (index < 0 or static_cast<size_type>(index) >= _words.size()) { return 0; }
+            return _words[static_cast<size_type>(index)];
+        }
+        /*
+         * the word_bits bits from index start (which may be negative), as
+         * if they were stored starting at the first bit of a word. Bits
+         * outside the elements are zero.
+         */
+        constexpr word_type _bits_from(difference_type start) const noexcept {
+            constexpr auto WORD_BITS = static_cast<difference_type>(word_bits);
+            difference_type position = start + static_cast<difference_type>(_first);
+            // rounded down rather than towards zero
+            difference_type index = position >= 0 ? position / WORD_BITS : -((WORD_BITS - 1 - position) / WORD_BITS);
+            auto shift = static_cast<unsigned>(position - index * WORD_BITS);
+            word_type bits = _word_or_zero(index) >> shift;
+            if (shift != 0) {
+                bits |= _word_or_zero(index + 1) << (word_bits - shift);
+            }
+            return bits;
+        }
+        /*
+         * calls combine on each of our words with the bits of other at the
+         * same indices. As bits outside the elements are zero in both, the
+         * same bits stay zero for &, | and ^.
+         */
+        template <typename Combine>
+        constexpr void _combine(const bit_sharray& other, Combine combine) {
+            if (other._size != _size) {
+                throw std::invalid_argument("bit_sharray sizes must match");
+            }
+            if (other._first == _first) {
+                // the bits line up, so the words do too
+                for (size_type i = 0; i < _words.size(); i++) {
+                    combine(_words[i], other._words[i]);
+                }
+                return;
+            }
+            for (size_type i = 0; i < _words.size(); i++) {
+                auto start = static_cast<difference_type>(i * word_bits) - static_cast<difference_type>(_first);
+                combine(_words[i], other._bits_from(start));
+            }
+        }
+
+        sharray<word_type, WordAllocator, GrowthPolicy> _words;
+        size_type _first = 0; // index of the first bit within the first word
+        size_type _size = 0;
+    };
+}
+
+#endif
@@ -0,0 +1,157 @@
+/*
+ * Created by Joshua Saxby <joshua.a.saxby@gmail.com>, October 2026
+ * Copyright Joshua Saxby <joshua.a.saxby@gmail.com> 2026
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef COM_SAXBOPHONE_CODLILI_FLAT_MAP_HPP
+#define COM_SAXBOPHONE_CODLILI_FLAT_MAP_HPP
+
+#include <functional>       // less
+#include <initializer_list> // initializer_list
+#include <stdexcept>        // out_of_range
+#include <tuple>            // forward_as_tuple
+#include <utility>          // forward, move, pair, piecewise_construct
+
+#include <codlili/flat_tree.hpp>
+#include <codlili/sharray.hpp>
+
+
+namespace com::saxbophone::codlili {
+    /**
+     * @brief A map from unique keys to values, kept sorted by key in a sharray
+     * @details Lookups are branchless binary searches over contiguous memory,
+     * so they're much faster than following the nodes of a std::map.
+     * Inserting and erasing are linear time, but only shift the elements on
+     * whichever side of the key has fewer of them, so it's at most half as
+     * much work as with a sorted std::vector.
+     * Ranges are inserted by sorting them and merging them in one pass.
+     * @note Inserting and erasing invalidates all iterators.
+     * @warning Unlike with std::map, elements are `std::pair<Key, T>` rather
+     * than `std::pair<const Key, T>`, so that they can be moved about, but
+     * their keys still mustn't be changed through iterators.
+     * @tparam Key the type of keys
+     * @tparam T the type of values
+     * @tparam Compare function object for ordering keys
+     * @tparam Container random access sequence container the elements are kept in
+     */
+    template <
+        typename Key,
+        typename T,
+        typename Compare = std::less<Key>,
+        typename Container = sharray<std::pair<Key, T>>
+    >
+    class flat_map : public detail::flat_tree<Key, std::pair<Key, T>, detail::first_key, Compare, Container> {
+    private:
+        using _base = detail::flat_tree<Key, std::pair<Key, T>, detail::first_key, Compare, Container>;
+    public:
+        using mapped_type = T;
+        using typename _base::value_type;
+        using typename _base::iterator;
+        using typename _base::const_iterator;
+        // compares elements by their keys
+        class value_compare {
+        public:
+            constexpr bool operator()(const value_type& lhs, const value_type& rhs) const {
+                return _compare(lhs.first, rhs.first);
+            }
+        private:
+            friend class flat_map;
+            constexpr value_compare(Compare compare) : _compare(compare) {}
+
+            [[no_unique_address]] Compare _compare;
+        };
+        // member functions
+        using _base::_base;
+        constexpr flat_map& operator=(std::initializer_list<value_type> ilist) {
+            *this = flat_map(ilist, this->_compare);
+            return *this;
+        }
+        // element access
+        constexpr T& at(const Key& key) {
+            return this->_elements.begin()[_index_of(key)].second;
+        }
+        constexpr const T& at(const Key& key) const {
+            return this->_at(_index_of(key)).second;
+        }
+        // inserts a value-initialised T if there's no element with key
+        constexpr T& operator[](const Key& key) {
+            return try_emplace(key).first->second;
+        }
+        constexpr T& operator[](Key&& key) {
+            return try_emplace(std::move(key)).first->second;
+        }
+        // modifiers
+        // constructs a value from args if there's no element with key, otherwise does nothing
+        template <class... Args>
+        constexpr std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args) {
+            return _try_emplace(key, std::forward<Args>(args)...);
+        }
+        template <class... Args>
+        constexpr std::pair<iterator, bool> try_emplace(Key&& key, Args&&... args) {
+            return _try_emplace(std::move(key), std::forward<Args>(args)...);
+        }
+        // inserts value if there's no element with key, otherwise assigns it to that element's value
+        template <class M>
+        constexpr std::pair<iterator, bool> insert_or_assign(const Key& key, M&& value) {
+            return _insert_or_assign(key, std::forward<M>(value));
+        }
+        template <class M>
+        constexpr std::pair<iterator, bool> insert_or_assign(Key&& key, M&& value) {
+            return _insert_or_assign(std::move(key), std::forward<M>(value));
+        }
+        constexpr void swap(flat_map& other) noexcept(noexcept(this->_elements.swap(other._elements))) {
+            using std::swap;
+            this->_elements.swap(other._elements);
+            swap(this->_compare, other._compare);
+        }
+        // observers
+        constexpr value_compare value_comp() const { return value_compare(this->_compare); }
+        // comparison
+        friend constexpr bool operator==(const flat_map& lhs, const flat_map& rhs) {
+            return lhs._elements == rhs._elements;
+        }
+        friend constexpr auto operator<=>(const flat_map& lhs, const flat_map& rhs) {
+            return lhs._elements <=> rhs._elements;
+        }
+        friend constexpr void swap(flat_map& lhs, flat_map& rhs) noexcept(noexcept(lhs.swap(rhs))) {
+            lhs.swap(rhs);
+        }
+    private:
+        // index of the element with key, throwing std::out_of_range if there isn't one
+        constexpr auto _index_of(const Key& key) const {
+            auto index = this->_find(key);
+            if (index == this->_size()) {
+                throw std::out_of_range("flat_map has no element with this key");
+            }
+            return index;
+        }
+        template <typename K, class... Args>
+        constexpr std::pair<iterator, bool> _try_emplace(K&& key, Args&&... args) {
+            auto index = this->_lower_bound(key);
+            if (index != this->_size() and not this->_compare(key, this->_at(index).first)) {
+                return {this->begin() + index, false};
+            }
+            auto position = this->_elements.emplace(
+                this->_elements.begin() + index,
+                std::piecewise_construct,
+                std::forward_as_tuple(std::forward<K>(key)),
+                std::forward_as_tuple(std::forward<Args>(args)...)
+            );
+            return {position, true};
+        }
+        template <typename K, class M>
+        constexpr std::pair<iterator, bool> _insert_or_assign(K&& key, M&& value) {
+            auto [position, inserted] = _try_emplace(std::forward<K>(key), std::forward<M>(value));
+            if (not inserted) {
+                position->second = std::forward<M>(value);
+            }
+            return {position, inserted};
+        }
+    };
+}
+
+#endif
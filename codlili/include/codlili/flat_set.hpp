@@ -0,0 +1,67 @@
+/*
+ * Created by Joshua Saxby <joshua.a.saxby@gmail.com>, October 2026
+ * Copyright Joshua Saxby <joshua.a.saxby@gmail.com> 2026
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef COM_SAXBOPHONE_CODLILI_FLAT_SET_HPP
+#define COM_SAXBOPHONE_CODLILI_FLAT_SET_HPP
+
+#include <functional>       // less
+#include <initializer_list> // initializer_list
+
+#include <codlili/flat_tree.hpp>
+#include <codlili/sharray.hpp>
+
+
+namespace com::saxbophone::codlili {
+    /**
+     * @brief A set of unique keys, kept sorted in a sharray
+     * @details Lookups are branchless binary searches over contiguous memory,
+     * so they're much faster than following the nodes of a std::set.
+     * Inserting and erasing are linear time, but only shift the elements on
+     * whichever side of the key has fewer of them, so it's at most half as
+     * much work as with a sorted std::vector.
+     * Ranges are inserted by sorting them and merging them in one pass.
+     * @note Inserting and erasing invalidates all iterators.
+     * @tparam Key the type of keys
+     * @tparam Compare function object for ordering keys
+     * @tparam Container random access sequence container the keys are kept in
+     */
+    template <typename Key, typename Compare = std::less<Key>, typename Container = sharray<Key>>
+    class flat_set : public detail::flat_tree<Key, Key, detail::identity_key, Compare, Container> {
+    private:
+        using _base = detail::flat_tree<Key, Key, detail::identity_key, Compare, Container>;
+    public:
+        using value_compare = Compare;
+        // member functions
+        using _base::_base;
+        constexpr flat_set& operator=(std::initializer_list<Key> ilist) {
+            *this = flat_set(ilist, this->_compare);
+            return *this;
+        }
+        // modifiers
+        constexpr void swap(flat_set& other) noexcept(noexcept(this->_elements.swap(other._elements))) {
+            using std::swap;
+            this->_elements.swap(other._elements);
+            swap(this->_compare, other._compare);
+        }
+        // observers
+        constexpr value_compare value_comp() const { return this->_compare; }
+        // comparison
+        friend constexpr bool operator==(const flat_set& lhs, const flat_set& rhs) {
+            return lhs._elements == rhs._elements;
+        }
+        friend constexpr auto operator<=>(const flat_set& lhs, const flat_set& rhs) {
+            return lhs._elements <=> rhs._elements;
+        }
+        friend constexpr void swap(flat_set& lhs, flat_set& rhs) noexcept(noexcept(lhs.swap(rhs))) {
+            lhs.swap(rhs);
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,350 @@
+/*
+ * Created by Joshua Saxby <joshua.a.saxby@gmail.com>, October 2026
+ * Copyright Joshua Saxby <joshua.a.saxby@gmail.com> 2026
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef COM_SAXBOPHONE_CODLILI_FLAT_TREE_HPP
+#define COM_SAXBOPHONE_CODLILI_FLAT_TREE_HPP
+
+#include <algorithm>        // inplace_merge, rotate, stable_sort, unique, upper_bound
+#include <initializer_list> // initializer_list
+#include <iterator>         // input_iterator, reverse_iterator
+#include <type_traits>      // conditional_t, is_constant_evaluated, is_convertible_v, is_same_v
+#include <utility>          // forward, move, pair
+
+#include <codlili/search.hpp>
+
+
+namespace com::saxbophone::codlili {
+    // tag telling flat_set and flat_map that a range is already sorted and has no equivalent keys
+    struct sorted_unique_t { explicit sorted_unique_t() = default; };
+    inline constexpr sorted_unique_t sorted_unique{};
+
+    namespace detail {
+        // the key of an element of a flat_set, which is the element itself
+        struct identity_key {
+            template <typename T>
+            constexpr const T& operator()(const T& element) const noexcept { return element; }
+        };
+
+        // the key of an element of a flat_map, which is its first member
+        struct first_key {
+            template <typename T>
+            constexpr const auto& operator()(const T& element) const noexcept { return element.first; }
+        };
+
+        // can Compare compare keys with objects of type K directly, without converting them to keys first?
+        template <typename K, typename Compare>
+        concept transparent_key = requires { typename Compare::is_transparent; };
+
+        /**
+         * @brief The parts of flat_set and flat_map which are the same
+         * @details Elements are kept sorted by key, with no two equivalent,
+         * in a sequence container. Looking up a key is a binary search.
+         * Inserting or erasing an element in the middle shifts the elements
+         * on one side of it. When the container is a sharray, that's the
+         * side with fewer elements, rather than always those after it.
+         * @tparam Key the type of the keys elements are sorted by
+         * @tparam Value the type of elements
+         * @tparam KeyOf function object giving the key of an element
+         * @tparam Compare function object comparing keys
+         * @tparam Container random access sequence container of elements
+         */
+        template <typename Key, typename Value, typename KeyOf, typename Compare, typename Container>
+        class flat_tree {
+        public:
+            using key_type = Key;
+            using value_type = Value;
+            using key_compare = Compare;
+            using container_type = Container;
+            using size_type = typename Container::size_type;
+            using difference_type = typename Container::difference_type;
+            using reference = value_type&;
+            using const_reference = const value_type&;
+            using const_iterator = typename Container::const_iterator;
+            // elements which are their own keys can't be changed, as that would change the order
+            using iterator = std::conditional_t<
+                std::is_same_v<Key, Value>, const_iterator, typename Container::iterator
+            >;
+            using reverse_iterator = std::reverse_iterator<iterator>;
+            using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+            // member functions
+            constexpr flat_tree() = default;
+            constexpr explicit flat_tree(const Compare& compare)
+              : _compare(compare)
+              {}
+            // the elements of container are sorted, keeping the first of any that are equivalent
+            constexpr explicit flat_tree(Container container, const Compare& compare = Compare())
+              : _elements(std::move(container))
+              , _compare(compare)
+              {
+                _merge_from(0, false);
+            }
+            constexpr flat_tree(sorted_unique_t, Container container, const Compare& compare = Compare())
+              : _elements(std::move(container))
+              , _compare(compare)
+              {}
+            template <std::input_iterator InputIt>
+            constexpr flat_tree(InputIt first, InputIt last, const Compare& compare = Compare())
+              : _compare(compare)
+              {
+                insert(first, last);
+            }
+            template <std::input_iterator InputIt>
+            constexpr flat_tree(
+                sorted_unique_t, InputIt first, InputIt last, const Compare& compare = Compare()
+            )
+              : _elements(first, last)
+              , _compare(compare)
+              {}
+            constexpr flat_tree(std::initializer_list<Value> init, const Compare& compare = Compare())
+              : flat_tree(init.begin(), init.end(), compare)
+              {}
+            constexpr flat_tree(
+                sorted_unique_t, std::initializer_list<Value> init, const Compare& compare = Compare()
+            )
+              : flat_tree(sorted_unique, init.begin(), init.end(), compare)
+              {}
+            // iterators
+            constexpr iterator begin() noexcept { return _elements.begin(); }
+            constexpr const_iterator begin() const noexcept { return _elements.begin(); }
+            constexpr const_iterator cbegin() const noexcept { return begin(); }
+            constexpr iterator end() noexcept { return _elements.end(); }
+            constexpr const_iterator end() const noexcept { return _elements.end(); }
+            constexpr const_iterator cend() const noexcept { return end(); }
+            constexpr reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+            constexpr const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+            constexpr const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+            constexpr reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+            constexpr const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+            constexpr const_reverse_iterator crend() const noexcept { return rend(); }
+            // capacity
+            [[nodiscard]] constexpr bool empty() const noexcept { return _elements.empty(); }
+            constexpr size_type size() const noexcept { return _elements.size(); }
+            constexpr size_type max_size() const noexcept { return _elements.max_size(); }
+            constexpr void reserve(size_type new_cap) { _elements.reserve(new_cap); }
+            constexpr size_type capacity() const noexcept { return _elements.capacity(); }
+            constexpr void shrink_to_fit() { _elements.shrink_to_fit(); }
+            // modifiers
+            template <class... Args>
+            constexpr std::pair<iterator, bool> emplace(Args&&... args) {
+                return _insert_unique(Value(std::forward<Args>(args)...));
+            }
+            template <class... Args>
+            constexpr iterator emplace_hint(const_iterator hint, Args&&... args) {
+                return _insert_unique(hint, Value(std::forward<Args>(args)...));
+            }
+            constexpr std::pair<iterator, bool> insert(const Value& value) {
+                return _insert_unique(value);
+            }
+            constexpr std::pair<iterator, bool> insert(Value&& value) {
+                return _insert_unique(std::move(value));
+            }
+            // inserting just before hint is constant time if that's where value belongs
+            constexpr iterator insert(const_iterator hint, const Value& value) {
+                return _insert_unique(hint, value);
+            }
+            constexpr iterator insert(const_iterator hint, Value&& value) {
+                return _insert_unique(hint, std::move(value));
+            }
+            /*
+             * the elements are appended, sorted, then merged with the existing
+             * ones in a single pass, rather than being inserted one at a time
+             */
+            template <std::input_iterator InputIt>
+            constexpr void insert(InputIt first, InputIt last) {
+                size_type old_size = size();
+                _elements.insert(_elements.end(), first, last);
+                _merge_from(old_size, false);
+            }
+            // as above, but the elements from first up to last are already sorted and unique
+            template <std::input_iterator InputIt>
+            constexpr void insert(sorted_unique_t, InputIt first, InputIt last) {
+                size_type old_size = size();
+                _elements.insert(_elements.end(), first, last);
+                _merge_from(old_size, true);
+            }
+            constexpr void insert(std::initializer_list<Value> ilist) {
+                insert(ilist.begin(), ilist.end());
+            }
+            constexpr void insert(sorted_unique_t, std::initializer_list<Value> ilist) {
+                insert(sorted_unique, ilist.begin(), ilist.end());
+            }
+            // moves the elements out, leaving this empty
+            constexpr Container extract() && {
+                Container elements = std::move(_elements);
+                _elements.clear();
+                return elements;
+            }
+            // elements must already be sorted and unique
+            constexpr void replace(Container&& elements) {
+                _elements = std::move(elements);
+            }
+            constexpr iterator erase(const_iterator pos) {
+                return _elements.erase(pos);
+            }
+            constexpr iterator erase(const_iterator first, const_iterator last) {
+                return _elements.erase(first, last);
+            }
+            constexpr size_type erase(const Key& key) {
+                return _erase_key(key);
+            }
+            template <transparent_key<Compare> K>
+            requires (not std::is_convertible_v<const K&, const_iterator>)
+            constexpr size_type erase(const K& key) {
+                return _erase_key(key);
+            }
+            constexpr void clear() noexcept { _elements.clear(); }
+            // lookup
+            constexpr iterator find(const Key& key) { return begin() + _find(key); }
+            constexpr const_iterator find(const Key& key) const { return begin() + _find(key); }
+            template <transparent_key<Compare> K>
+            constexpr iterator find(const K& key) { return begin() + _find(key); }
+            template <transparent_key<Compare> K>
+            constexpr const_iterator find(const K& key) const { return begin() + _find(key); }
+            constexpr size_type count(const Key& key) const { return contains(key) ? 1 : 0; }
+            template <transparent_key<Compare> K>
+            constexpr size_type count(const K& key) const { return contains(key) ? 1 : 0; }
+            constexpr bool contains(const Key& key) const { return _find(key) != _size(); }
+            template <transparent_key<Compare> K>
+            constexpr bool contains(const K& key) const { return _find(key) != _size(); }
+            constexpr iterator lower_bound(const Key& key) { return begin() + _lower_bound(key); }
+            constexpr const_iterator lower_bound(const Key& key) const { return begin() + _lower_bound(key); }
+            template <transparent_key<Compare> K>
+            constexpr iterator lower_bound(const K& key) { return begin() + _lower_bound(key); }
+            template <transparent_key<Compare> K>
+            constexpr const_iterator lower_bound(const K& key) const { return begin() + _lower_bound(key); }
+            constexpr iterator upper_bound(const Key& key) { return begin() + _upper_bound(key); }
+            constexpr const_iterator upper_bound(const Key& key) const { return begin() + _upper_bound(key); }
+            template <transparent_key<Compare> K>
+            constexpr iterator upper_bound(const K& key) { return begin() + _upper_bound(key); }
+            template <transparent_key<Compare> K>
+            constexpr const_iterator upper_bound(const K& key) const { return begin() + _upper_bound(key); }
+            constexpr std::pair<iterator, iterator> equal_range(const Key& key) {
+                return {lower_bound(key), upper_bound(key)};
+            }
+            constexpr std::pair<const_iterator, const_iterator> equal_range(const Key& key) const {
+                return {lower_bound(key), upper_bound(key)};
+            }
+            template <transparent_key<Compare> K>
+            constexpr std::pair<iterator, iterator> equal_range(const K& key) {
+                return {lower_bound(key), upper_bound(key)};
+            }
+            template <transparent_key<Compare> K>
+            constexpr std::pair<const_iterator, const_iterator> equal_range(const K& key) const {
+                return {lower_bound(key), upper_bound(key)};
+            }
+            // observers
+            constexpr key_compare key_comp() const { return _compare; }
+        protected:
+            constexpr const Key& _key(const Value& element) const { return KeyOf()(element); }
+            // is the element at index less than key?
+            template <typename K>
+            constexpr bool _before(const Value& element, const K& key) const {
+                return _compare(_key(element), key);
+            }
+            constexpr difference_type _size() const noexcept {
+                return static_cast<difference_type>(_elements.size());
+            }
+            // index of the first element not less than key
+            template <typename K>
+            constexpr difference_type _lower_bound(const K& key) const {
+                auto found = detail::branchless_lower_bound(
+                    _elements.begin(), _elements.end(), key,
+                    [this](const Value& element, const K& k) { return _before(element, k); }
+                );
+                return found - _elements.begin();
+            }
+            // index of the first element greater than key
+            template <typename K>
+            constexpr difference_type _upper_bound(const K& key) const {
+                auto found = detail::branchless_lower_bound(
+                    _elements.begin(), _elements.end(), key,
+                    [this](const Value& element, const K& k) { return not _compare(k, _key(element)); }
+                );
+                return found - _elements.begin();
+            }
+            // index of the element with key, or _size() if there isn't one
+            template <typename K>
+            constexpr difference_type _find(const K& key) const {
+                difference_type index = _lower_bound(key);
+                if (index != _size() and _compare(key, _key(_at(index)))) { return _size(); }
+                return index;
+            }
+            constexpr const Value& _at(difference_type index) const {
+                return _elements.begin()[index];
+            }
+            // inserts value where it belongs, unless there's already an element with an equivalent key
+            template <typename V>
+            constexpr std::pair<iterator, bool> _insert_unique(V&& value) {
+                difference_type index = _lower_bound(_key(value));
+                if (index != _size() and not _compare(_key(value), _key(_at(index)))) {
+                    return {begin() + index, false};
+                }
+                return {_elements.insert(_elements.begin() + index, std::forward<V>(value)), true};
+            }
+            // as above, but checks whether value belongs just before hint first
+            template <typename V>
+            constexpr iterator _insert_unique(const_iterator hint, V&& value) {
+                if (
+                    (hint == cbegin() or _before(*(hint - 1), _key(value))) and
+                    (hint == cend() or _compare(_key(value), _key(*hint)))
+                ) {
+                    return _elements.insert(hint, std::forward<V>(value));
+                }
+                return _insert_unique(std::forward<V>(value)).first;
+            }
+            template <typename K>
+            constexpr size_type _erase_key(const K& key) {
+                difference_type index = _find(key);
+                if (index == _size()) { return 0; }
+                _elements.erase(_elements.begin() + index);
+                return 1;
+            }
+            /*
+             * merges the elements from index first onwards, which are already
+             * sorted if sorted is true, into those before them, then removes
+             * all but the first of any equivalent elements, so existing ones
+             * are kept over new ones
+             */
+            constexpr void _merge_from(size_type first, bool sorted) {
+                auto less = [this](const Value& lhs, const Value& rhs) {
+                    return _compare(_key(lhs), _key(rhs));
+                };
+                auto start = _elements.begin();
+                auto middle = start + static_cast<difference_type>(first);
+                auto stop = _elements.end();
+                if (middle == stop) { return; }
+                if (std::is_constant_evaluated()) {
+                    // stable_sort() and inplace_merge() aren't constexpr, so insert each new element after its equals
+                    for (auto element = middle; element != stop; ++element) {
+                        std::rotate(std::upper_bound(start, element, *element, less), element, element + 1);
+                    }
+                } else {
+                    if (not sorted) {
+                        std::stable_sort(middle, stop, less);
+                    }
+                    // appending elements greater than all the existing ones needs no merge
+                    if (middle != start and not less(*(middle - 1), *middle)) {
+                        std::inplace_merge(start, middle, stop, less);
+                    } else if (sorted) {
+                        return;
+                    }
+                }
+                auto last = std::unique(start, stop, [&](const Value& lhs, const Value& rhs) {
+                    return not less(lhs, rhs);
+                });
+                _elements.erase(last, stop);
+            }
+
+            Container _elements;
+            [[no_unique_address]] Compare _compare;
+        };
+    }
+}
+
+#endif
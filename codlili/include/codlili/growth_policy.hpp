@@ -0,0 +1,131 @@
+/*
+ * Created by Joshua Saxby <joshua.a.saxby@gmail.com>, October 2026
+ * Copyright Joshua Saxby <joshua.a.saxby@gmail.com> 2026
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef COM_SAXBOPHONE_CODLILI_GROWTH_POLICY_HPP
+#define COM_SAXBOPHONE_CODLILI_GROWTH_POLICY_HPP
+
+#include <cstddef>          // size_t
+
+#include <algorithm>        // max, min
+#include <bit>              // bit_ceil
+#include <concepts>         // convertible_to
+#include <limits>           // numeric_limits
+
+
+namespace com::saxbophone::codlili {
+    /**
+     * @brief A policy deciding how much storage a container allocates when it
+     * runs out of space
+     * @details `GrowthPolicy::capacity_for(needed, capacity)` is given the
+     * number of elements which need storing and the current capacity, and
+     * returns the capacity to reallocate to, which must be at least `needed`.
+     * Returning more than `needed` leaves spare space for future insertions,
+     * making them amortised O(1) as long as capacity grows geometrically.
+     */
+    template <class Policy>
+    concept growth_policy = requires (std::size_t needed, std::size_t capacity) {
+        { Policy::capacity_for(needed, capacity) } -> std::convertible_to<std::size_t>;
+    };
+
+    /**
+     * @brief Grows capacity to Numerator / Denominator times what's needed
+     * @note Always leaves space for at least one more element, unless the
+     * capacity can't get any bigger
+     */
+    template <std::size_t Numerator, std::size_t Denominator = 1>
+    requires (Numerator > Denominator and Denominator > 0)
+    struct geometric_growth {
+        static constexpr std::size_t capacity_for(std::size_t needed, std::size_t) {
+            constexpr std::size_t MAX = std::numeric_limits<std::size_t>::max();
+            if (needed > MAX / Numerator) { // can't grow any further without overflowing
+                return needed;
+            }
+            return std::max(needed * Numerator / Denominator, needed + 1);
+        }
+    };
+
+    /**
+     * @brief Grows capacity to Increment more than what's needed
+     * @warning Insertions are amortised O(n) rather than O(1) with this policy,
+     * but at most Increment elements' worth of storage is ever wasted.
+     */
+    template <std::size_t Increment>
+    requires (Increment > 0)
+    struct fixed_growth {
+        static constexpr std::size_t capacity_for(std::size_t needed, std::size_t) {
+            return needed + Increment;
+        }
+    };
+
+    /**
+     * @brief Grows capacity to the smallest power of two greater than what's
+     * needed, for allocators which work best with such sizes
+     */
+    struct power_of_two_growth {
+        static constexpr std::size_t capacity_for(std::size_t needed, std::size_t) {
+            return std::bit_ceil(needed + 1);
+        }
+    };
+
+    // 1.5x growth, which wastes less memory at the cost of more reallocations
+    using growth_1_5x = geometric_growth<3, 2>;
+    // 2x growth, as most std::vector implementations use
+    using growth_2x = geometric_growth<2>;
+    // 3x growth, which leaves room to grow at both ends of a sharray
+    using growth_3x = geometric_growth<3>;
+    // the growth policy used by codlili's containers unless another is given
+    using default_growth = growth_3x;
+
+    /**
+     * @brief A growth policy which also decides when a container should give
+     * back storage after elements are removed
+     * @details `GrowthPolicy::shrink_capacity_for(size, capacity)` is given
+     * the number of elements left and the current capacity, and returns the
+     * capacity to shrink to, or `capacity` (or more) to leave it unchanged.
+     */
+    template <class Policy>
+    concept shrinking_growth_policy = growth_policy<Policy> and requires (
+        std::size_t size, std::size_t capacity
+    ) {
+        { Policy::shrink_capacity_for(size, capacity) } -> std::convertible_to<std::size_t>;
+    };
+
+    /**
+     * @brief Adds automatic shrinking to another growth policy
+     * @details Once fewer than Percent% of the capacity is in use, storage is
+     * shrunk to what GrowthPolicy would grow it to for the remaining elements,
+     * or freed altogether if there are none left.
+     * The new capacity is capped so that the elements fill it at least halfway
+     * between Percent% and full, which leaves room to spare but makes it take
+     * a number of removals in proportion to the size before it shrinks again,
+     * or insertions before it grows again, whatever GrowthPolicy grows by.
+     * Otherwise, a policy growing by more than 100 / Percent times would leave
+     * it below the threshold straight after growing, or only just above it
+     * after shrinking, and it would thrash between reallocations.
+     * @tparam GrowthPolicy the policy to use for growing
+     * @tparam Percent the occupancy below which to shrink
+     */
+    template <growth_policy GrowthPolicy = default_growth, std::size_t Percent = 25>
+    requires (Percent > 0 and Percent < 100)
+    struct auto_shrink : GrowthPolicy {
+        static constexpr std::size_t shrink_capacity_for(std::size_t size, std::size_t capacity) {
+            // compared without multiplying size by 100, which could overflow
+            if (size >= capacity / 100 * Percent + capacity % 100 * Percent / 100) {
+                return capacity;
+            }
+            if (size == 0) { return 0; }
+            // the capacity size fills to halfway between Percent% and full, also without overflowing
+            constexpr std::size_t HALFWAY = 100 + Percent;
+            std::size_t most = size / HALFWAY * 200 + size % HALFWAY * 200 / HALFWAY;
+            return std::min(GrowthPolicy::capacity_for(size, capacity), most);
+        }
+    };
+}
+
+#endif
@@ -12,23 +12,32 @@
 
 #include <cstddef>           // size_t
 #include <algorithm>         // swap
+#include <functional>        // equal_to, less
 #include <initializer_list>  // initializer_list
 #include <iterator>          // iterator traits
+#include <memory>            // allocator, allocator_traits
+#include <utility>           // forward, in_place, in_place_t, move, pair, swap
 
 
 namespace com::saxbophone::codlili {
     // TODO: rearrange the list of method prototypes to follow those of std::list
-    template <typename T>  // the type of elements to store
+    template <
+        typename T,                           // the type of elements to store
+        class Allocator = std::allocator<T>   // rebound to allocate the nodes
+    >
     class list {
     public:
+        // links of the doubly-linked-list nodes, and of the node one past the end, which holds no element
+        struct ListLinks {
+            ListLinks* next = nullptr;
+            ListLinks* prev = nullptr;
+        };
         // simple record type for the doubly-linked-list nodes
-        struct ListNode {
-            constexpr ListNode() {}
-            constexpr ListNode(T value, ListNode* next) : next(next), value(value) {}
-            constexpr ListNode(ListNode* prev, T value, ListNode* next) : next(next), prev(prev), value(value) {}
-            ListNode* next = nullptr;
-            ListNode* prev = nullptr;
-            T value = {};
+        struct ListNode : ListLinks {
+            // the value is constructed directly from the given arguments
+            template <typename... Args>
+            constexpr explicit ListNode(std::in_place_t, Args&&... args) : value(std::forward<Args>(args)...) {}
+            T value;
         };
         struct iterator {
             using iterator_category = std::bidirectional_iterator_tag;
@@ -37,9 +46,9 @@ namespace com::saxbophone::codlili {
             using pointer = T*;
             using reference = T&;
 
-            constexpr iterator(ListNode* node) : _cursor(node) {}
-            constexpr reference operator*() const { return _cursor->value; }
-            constexpr pointer operator->() { return &_cursor->value; }
+            constexpr iterator(ListLinks* node) : _cursor(node) {}
+            constexpr reference operator*() const { return static_cast<ListNode*>(_cursor)->value; }
+            constexpr pointer operator->() { return &static_cast<ListNode*>(_cursor)->value; }
             constexpr iterator& operator++() {
                 _cursor = _cursor->next;
                 return *this;
@@ -61,116 +70,159 @@ namespace com::saxbophone::codlili {
             // comparison
             constexpr friend bool operator==(const iterator& a, const iterator& b) = default;
         private:
-            ListNode* _cursor;
+            friend list; // for splicing the node at an iterator
+            ListLinks* _cursor;
         };
         using reverse_iterator = std::reverse_iterator<iterator>;
         using reference = T&;
         using const_reference = const T&;
-        // initialises size to zero, an empty list
-        constexpr list() noexcept {}
+        using allocator_type = Allocator;
+        // initialises size to zero, an empty list, which doesn't allocate
+        constexpr list() noexcept(noexcept(NodeAllocator())) {}
+        // initialises an empty list which allocates its nodes with the given allocator
+        constexpr explicit list(const Allocator& allocator) noexcept : _allocator(allocator) {}
         // initialises list with the specified number of default-constructed elements
-        constexpr list(std::size_t size) : list(size, T{}) {} // reuse (size,value) ctor
+        constexpr list(std::size_t size, const Allocator& allocator = Allocator())
+          : list(size, T{}, allocator) {} // reuse (size,value) ctor
         // initialises list with the given elements
-        constexpr list(std::initializer_list<T> elements) {
-            for (auto element : elements) {
+        constexpr list(std::initializer_list<T> elements, const Allocator& allocator = Allocator())
+          : _allocator(allocator)
+          {
+            for (const auto& element : elements) {
                 push_back(element);
             }
         }
         // initialises list with the specified number of this element value-copied
-        constexpr list(std::size_t size, const_reference value) {
+        constexpr list(std::size_t size, const_reference value, const Allocator& allocator = Allocator())
+          : _allocator(allocator)
+          {
             for (std::size_t i = 0; i < size; i++) {
                 push_back(value);
             }
         }
-        /* rule of three: */
+        /* rule of five: */
         // copy constructor
-        constexpr list(const list& other) {
-            for (auto element : other) {
+        constexpr list(const list& other)
+          : list(other, NodeTraits::select_on_container_copy_construction(other._allocator))
+          {}
+        // copy constructor which allocates the copy's nodes with the given allocator
+        constexpr list(const list& other, const Allocator& allocator) : _allocator(allocator) {
+            for (const auto& element : other) {
                 push_back(element);
             }
         }
+        // move constructor, which takes other's nodes and leaves it empty
+        constexpr list(list&& other) noexcept : _allocator(std::move(other._allocator)) {
+            _take_nodes(other);
+        }
+        // move constructor which allocates with the given allocator, taking other's nodes only if it can free them
+        constexpr list(list&& other, const Allocator& allocator) : _allocator(allocator) {
+            if (_allocator == other._allocator) {
+                _take_nodes(other);
+                return;
+            }
+            for (auto& element : other) {
+                push_back(std::move(element));
+            }
+        }
         // destructor, needed because there is manual memory management
         constexpr ~list() {
-            // delete the entire chain of ListNode pointers
-            auto cursor = _back;
-            while (cursor != nullptr) {
-                auto next = cursor->prev;
-                delete cursor;
-                cursor = next;
-            }
-            _front = nullptr;
-            _back = nullptr;
+            clear();
         }
         // copy assignment operator
-        constexpr list& operator=(const list& other) noexcept {
+        constexpr list& operator=(const list& other) {
+            if (this == &other) {
+                return *this;
+            }
+            // our nodes go first, using the allocator they came from
             clear();
-            for (auto element : other) {
+            if constexpr (NodeTraits::propagate_on_container_copy_assignment::value) {
+                _allocator = other._allocator;
+            }
+            for (const auto& element : other) {
                 push_back(element);
             }
             return *this;
         }
+        // move assignment operator, which takes other's nodes if our allocator will be able to free them
+        constexpr list& operator=(list&& other) noexcept(
+            NodeTraits::propagate_on_container_move_assignment::value or NodeTraits::is_always_equal::value
+        ) {
+            if (this == &other) {
+                return *this;
+            }
+            clear();
+            if constexpr (NodeTraits::propagate_on_container_move_assignment::value) {
+                _allocator = other._allocator;
+            } else if (_allocator != other._allocator) {
+                for (auto& element : other) {
+                    push_back(std::move(element));
+                }
+                return *this;
+            }
+            _take_nodes(other);
+            return *this;
+        }
+        // returns a copy of the allocator the nodes are allocated with
+        constexpr allocator_type get_allocator() const noexcept { return allocator_type(_allocator); }
         /* element access */
         // TODO: make these trap when accessed on an empty list
         // get reference to first element
-        constexpr reference front() { return this->_front->value; }
+        constexpr reference front() { return _value(_end.next); }
         // get read-only reference to first element
-        constexpr const_reference front() const { return this->_front->value; }
+        constexpr const_reference front() const { return _value(_end.next); }
         // get reference to last element
-        constexpr reference back() { return this->_back->prev->value; }
+        constexpr reference back() { return _value(_end.prev); }
         // get read-only reference to last element
-        constexpr const_reference back() const { return this->_back->prev->value; }
+        constexpr const_reference back() const { return _value(_end.prev); }
         /* iterators */
-        constexpr iterator begin() { return iterator(_front); }
-        constexpr iterator end() { return iterator(_back); } // 1 past the end, out of bounds
-        constexpr iterator begin() const { return iterator(_front); }
-        constexpr iterator end() const { return iterator(_back); } // 1 past the end, out of bounds
+        constexpr iterator begin() { return iterator(_end.next); }
+        constexpr iterator end() { return iterator(&_end); } // 1 past the end, out of bounds
+        constexpr iterator begin() const { return iterator(_end.next); }
+        // 1 past the end, out of bounds, so there's no element to modify through it
+        constexpr iterator end() const { return iterator(const_cast<ListLinks*>(&_end)); }
         constexpr reverse_iterator rbegin() { return reverse_iterator(end()); }
         constexpr reverse_iterator rend() { return reverse_iterator(begin()); }
         constexpr reverse_iterator rbegin() const { return reverse_iterator(end()); }
         constexpr reverse_iterator rend() const { return reverse_iterator(begin()); }
         /* capacity */
         // is list empty?
-        constexpr bool empty() const noexcept { return _front == _back; }
+        constexpr bool empty() const noexcept { return _size == 0; }
         // get size of list in number of elements
-        constexpr std::size_t size() const noexcept {
-            // count the number of elements
-            std::size_t count = 0;
-            for (auto it[[maybe_unused]] : *this) {
-                count++;
-            }
-            return count;
-        }
+        constexpr std::size_t size() const noexcept { return _size; }
         /* modifiers */
         // erases all elements from the list, .size() = 0 after this call
         constexpr void clear() noexcept {
-            // delete all except back, and reset front to back after
-            auto cursor = _back->prev;
-            while (cursor != nullptr) {
-                auto next = cursor->prev;
-                delete cursor;
-                cursor = next;
-            }
-            // reset back's links and set front to back
-            _back->prev = nullptr;
-            _front = _back;
+            // the last node's next is the one past the end, which is never deleted
+            _end.prev->next = nullptr;
+            _delete_chain(_end.next);
+            _end.next = &_end;
+            _end.prev = &_end;
+            _size = 0;
         }
         // prepends the given element value to the front of the list
-        constexpr void push_front(const_reference value) {
-            auto old_front = _front;
-            _front = new ListNode(value, old_front);
-            // create the back-link from old front to new front
-            old_front->prev = _front;
+        constexpr void push_front(const_reference value) { emplace_front(value); }
+        // prepends the given element value to the front of the list, moving it into place
+        constexpr void push_front(T&& value) { emplace_front(std::move(value)); }
+        // prepends an element constructed in place from the given arguments, returning a reference to it
+        template <typename... Args>
+        constexpr reference emplace_front(Args&&... args) {
+            ListNode* added = _new_node(std::forward<Args>(args)...);
+            _link_chain(_end.next, {added, added});
+            _size++;
+            return added->value;
         }
         // appends the given element value to the end of the list
-        constexpr void push_back(const_reference value) {
-            // when empty it's the same as push_front()
-            if (empty()) { return push_front(value); }
-            // insert between back and back-1
-            auto behind = _back->prev;
-            ListNode* added = new ListNode(behind, value, _back);
-            // create back-references
-            behind->next = added;
-            _back->prev = added;
+        constexpr void push_back(const_reference value) { emplace_back(value); }
+        // appends the given element value to the end of the list, moving it into place
+        constexpr void push_back(T&& value) { emplace_back(std::move(value)); }
+        // appends an element constructed in place from the given arguments, returning a reference to it
+        template <typename... Args>
+        constexpr reference emplace_back(Args&&... args) {
+            ListNode* added = _new_node(std::forward<Args>(args)...);
+            _link_chain(&_end, {added, added});
+            _size++;
+            return added->value;
         }
         // prepends size copies of the given element value to the front of the list
         constexpr void push_front(std::size_t size, const_reference value) {
@@ -186,57 +238,348 @@ namespace com::saxbophone::codlili {
         }
         // removes the first element from the list
         constexpr void pop_front() {
-            auto old_front = _front; // keep reference to old front
-            _front = old_front->next; // set the 2nd element to be the new front
-            if (_front == _back) { // if front is now back marker, list is now empty, so set back->prev
-                _back->prev = nullptr;
-            } else { // otherwise, just clear prev pointer of new front node
-                _front->prev = nullptr;
-            }
-            delete old_front;
+            ListLinks* old_front = _end.next;
+            _unlink_chain(old_front, old_front->next);
+            _delete_node(old_front);
+            _size--;
         }
         // removes the last element from the list
         constexpr void pop_back() {
-            auto old_back = _back;
-            _back = old_back->prev;
-            if (_front == _back) { // if front is now back marker, list is now empty, so set front->next
-                _front->next = nullptr;
-            } else { // otherwise, just clear next pointer of new back node
-                _back->next = nullptr;
-            }
-            delete old_back;
+            ListLinks* old_back = _end.prev;
+            _unlink_chain(old_back, &_end);
+            _delete_node(old_back);
+            _size--;
         }
         // resizes the list to hold count elements, removing excess elements if count less than current size, or adding
         // new default-constructed elements at the end if it is greater
-        constexpr void resize(std::size_t count) { return resize(count, T{}); }
+        constexpr void resize(std::size_t count) {
+            while (_size > count) {
+                pop_back();
+            }
+            while (_size < count) {
+                emplace_back();
+            }
+        }
         // resizes the list to hold count elements, removing excess elements if count less than current size, or adding
         // new copies of value at the end if it is greater
         constexpr void resize(std::size_t count, const_reference value) {
-            std::size_t current_size = size();
-            if (count < current_size) { // remove elements
-                for (std::size_t i = current_size; i > count; i--) {
-                    pop_back();
-                }
-            } else { // add elements
-                for (std::size_t i = current_size; i < count; i++) {
-                    push_back(value);
-                }
+            while (_size > count) { // remove elements
+                pop_back();
+            }
+            while (_size < count) { // add elements
+                push_back(value);
             }
         }
         // exchanges this list's contents with that of the other
         constexpr void swap(list& other) noexcept {
-            // swapping the front and back pointers should be enough to exchange contents
-            std::swap(_front, other._front);
-            std::swap(_back, other._back);
+            // the ends of each chain of nodes are relinked to the other's node past the end
+            ListLinks* first = _end.next;
+            ListLinks* last = _end.prev;
+            std::size_t size = _size;
+            _link_ends(other._end.next, other._end.prev, other._size);
+            other._link_ends(first, last, size);
+            if constexpr (NodeTraits::propagate_on_container_swap::value) {
+                std::swap(_allocator, other._allocator);
+            }
+        }
+        /* operations */
+        // these relink nodes rather than copying elements, so none of them allocate
+        // moves all elements of other to before pos, other's allocator must compare equal to ours
+        constexpr void splice(iterator pos, list& other) noexcept {
+            if (this == &other or other.empty()) { return; }
+            _size += other._size;
+            other._size = 0;
+            _link_chain(pos._cursor, other._unlink_chain(other._end.next, &other._end));
+        }
+        // moves the element of other at it to before pos
+        constexpr void splice(iterator pos, list& other, iterator it) noexcept {
+            if (pos == it or pos._cursor == it._cursor->next) { return; }
+            other._size--;
+            _size++;
+            _link_chain(pos._cursor, other._unlink_chain(it._cursor, it._cursor->next));
+        }
+        // moves the elements of other in [first, last) to before pos, which mustn't be one of them
+        // this is linear in the number of elements moved, to count them, unless other is this list
+        constexpr void splice(iterator pos, list& other, iterator first, iterator last) noexcept {
+            if (first == last) { return; }
+            if (this != &other) {
+                std::size_t count = 0;
+                for (auto it = first; it != last; ++it) {
+                    count++;
+                }
+                other._size -= count;
+                _size += count;
+            }
+            _link_chain(pos._cursor, other._unlink_chain(first._cursor, last._cursor));
+        }
+        // merges other into this list, both of which must be sorted, keeping the order of equal elements
+        constexpr void merge(list& other) { merge(other, std::less<>()); }
+        template <class Compare>
+        constexpr void merge(list& other, Compare comp) {
+            if (this == &other) { return; }
+            ListLinks* cursor = _end.next;
+            while (not other.empty()) {
+                ListLinks* first = other._end.next;
+                // other's elements go after all of ours which they're not less than
+                while (cursor != &_end and not comp(_value(first), _value(cursor))) {
+                    cursor = cursor->next;
+                }
+                if (cursor == &_end) {
+                    return splice(end(), other);
+                }
+                // then take as long a run of them as goes before the same element of ours
+                ListLinks* last = first->next;
+                std::size_t count = 1;
+                while (last != &other._end and comp(_value(last), _value(cursor))) {
+                    last = last->next;
+                    count++;
+                }
+                other._size -= count;
+                _size += count;
+                _link_chain(cursor, other._unlink_chain(first, last));
+            }
+        }
+        // sorts the elements, keeping the order of equal elements, with a bottom-up merge sort
+        constexpr void sort() { sort(std::less<>()); }
+        template <class Compare>
+        constexpr void sort(Compare comp) {
+            if (_size < 2) { return; }
+            // sorted runs of up to 2^i nodes, each of which came before all those in lower bins
+            ListLinks* bins[64] = {};
+            // the nodes to sort are a chain joined only by next, ending with nullptr
+            auto [unsorted, tail] = _unlink_chain(_end.next, &_end);
+            tail->next = nullptr;
+            ListLinks* carry = nullptr;
+            try {
+                while (unsorted != nullptr) {
+                    carry = unsorted;
+                    unsorted = unsorted->next;
+                    carry->next = nullptr;
+                    std::size_t i = 0;
+                    for (; bins[i] != nullptr; i++) {
+                        carry = _merge_chains(bins[i], carry, comp);
+                        bins[i] = nullptr;
+                    }
+                    bins[i] = carry;
+                    carry = nullptr;
+                }
+                for (ListLinks*& bin : bins) {
+                    if (bin != nullptr) {
+                        carry = _merge_chains(bin, carry, comp);
+                        bin = nullptr;
+                    }
+                }
+            } catch (...) {
+                // put every node back, in whatever order they're in now
+                for (ListLinks* bin : bins) {
+                    carry = _join_chains(bin, carry);
+                }
+                _relink_chain(_join_chains(carry, unsorted));
+                throw;
+            }
+            _relink_chain(carry);
+        }
+        // reverses the order of the elements
+        constexpr void reverse() noexcept {
+            if (_size < 2) { return; }
+            for (ListLinks* node = _end.next; node != &_end; node = node->prev) {
+                std::swap(node->next, node->prev);
+            }
+            std::swap(_end.next, _end.prev);
+        }
+        // removes all but the first of each run of consecutive equal elements, returning how many were removed
+        constexpr std::size_t unique() { return unique(std::equal_to<>()); }
+        template <class BinaryPredicate>
+        constexpr std::size_t unique(BinaryPredicate p) {
+            if (_size < 2) { return 0; }
+            ListLinks* removed = nullptr;
+            std::size_t count = 0;
+            ListLinks* kept = _end.next;
+            try {
+                while (kept->next != &_end) {
+                    ListLinks* node = kept->next;
+                    if (p(_value(kept), _value(node))) {
+                        _unlink_chain(node, node->next);
+                        node->next = removed;
+                        removed = node;
+                        count++;
+                    } else {
+                        kept = node;
+                    }
+                }
+            } catch (...) {
+                _delete_chain(removed);
+                _size -= count;
+                throw;
+            }
+            _delete_chain(removed);
+            _size -= count;
+            return count;
+        }
+        // removes all elements equal to value, returning how many were removed
+        constexpr std::size_t remove(const_reference value) {
+            // value may be one of ours, so nodes are only deleted once they've all been compared with it
+            return remove_if([&value](const_reference element) { return element == value; });
+        }
+        // removes all elements for which p returns true, returning how many were removed
+        template <class UnaryPredicate>
+        constexpr std::size_t remove_if(UnaryPredicate p) {
+            ListLinks* removed = nullptr;
+            std::size_t count = 0;
+            ListLinks* node = _end.next;
+            try {
+                while (node != &_end) {
+                    ListLinks* next = node->next;
+                    if (p(_value(node))) {
+                        _unlink_chain(node, next);
+                        node->next = removed;
+                        removed = node;
+                        count++;
+                    }
+                    node = next;
+                }
+            } catch (...) {
+                _delete_chain(removed);
+                _size -= count;
+                throw;
+            }
+            _delete_chain(removed);
+            _size -= count;
+            return count;
         }
         /* comparison */
         constexpr bool operator==(const list& other) const {
-            return std::equal(begin(), end(), other.begin(), other.end());
+            return _size == other._size and std::equal(begin(), end(), other.begin());
         }
     private:
-        // front and back pointers
-        ListNode* _front = new ListNode();
-        ListNode* _back = _front;
+        using NodeAllocator = std::allocator_traits<Allocator>::template rebind_alloc<ListNode>;
+        using NodeTraits = std::allocator_traits<NodeAllocator>;
+
+        // the element of a node which isn't the one past the end
+        static constexpr T& _value(ListLinks* node) { return static_cast<ListNode*>(node)->value; }
+        // allocates a node and constructs its element from the given arguments
+        template <typename... Args>
+        constexpr ListNode* _new_node(Args&&... args) {
+            ListNode* node = NodeTraits::allocate(_allocator, 1);
+            try {
+                NodeTraits::construct(_allocator, node, std::in_place, std::forward<Args>(args)...);
+            } catch (...) {
+                NodeTraits::deallocate(_allocator, node, 1);
+                throw;
+            }
+            return node;
+        }
+        constexpr void _delete_node(ListLinks* links) noexcept {
+            ListNode* node = static_cast<ListNode*>(links);
+            NodeTraits::destroy(_allocator, node);
+            NodeTraits::deallocate(_allocator, node, 1);
+        }
+        // deletes a chain of nodes joined by next and ending with nullptr
+        constexpr void _delete_chain(ListLinks* chain) noexcept {
+            while (chain != nullptr) {
+                auto next = chain->next;
+                _delete_node(chain);
+                chain = next;
+            }
+        }
+        /*
+         * unlinks the nodes from first up to but not including last, which
+         * mustn't be the same, returning the first and last of them, which
+         * are still linked to each other
+         */
+        static constexpr std::pair<ListLinks*, ListLinks*> _unlink_chain(
+            ListLinks* first, ListLinks* last
+        ) noexcept {
+            ListLinks* before = first->prev;
+            ListLinks* tail = last->prev;
+            before->next = last;
+            last->prev = before;
+            return {first, tail};
+        }
+        // links a chain returned by _unlink_chain() in before pos
+        static constexpr void _link_chain(ListLinks* pos, std::pair<ListLinks*, ListLinks*> chain) noexcept {
+            auto [first, tail] = chain;
+            ListLinks* before = pos->prev;
+            first->prev = before;
+            before->next = first;
+            tail->next = pos;
+            pos->prev = tail;
+        }
+        // makes the nodes of a chain joined by next and ending with nullptr our elements, fixing their prev links
+        constexpr void _relink_chain(ListLinks* chain) noexcept {
+            ListLinks* prev = &_end;
+            for (ListLinks* node = chain; node != nullptr; node = node->next) {
+                node->prev = prev;
+                prev->next = node;
+                prev = node;
+            }
+            prev->next = &_end;
+            _end.prev = prev;
+        }
+        // makes the chain of nodes from first to last ours, or none if size is 0
+        constexpr void _link_ends(ListLinks* first, ListLinks* last, std::size_t size) noexcept {
+            if (size == 0) {
+                _end.next = &_end;
+                _end.prev = &_end;
+            } else {
+                _end.next = first;
+                _end.prev = last;
+                first->prev = &_end;
+                last->next = &_end;
+            }
+            _size = size;
+        }
+        constexpr void _take_nodes(list& other) noexcept {
+            _link_ends(other._end.next, other._end.prev, other._size);
+            other._link_ends(nullptr, nullptr, 0);
+        }
+        // appends the chain b, joined by next and ending with nullptr, to the end of the chain a
+        static constexpr ListLinks* _join_chains(ListLinks* a, ListLinks* b) noexcept {
+            if (a == nullptr) { return b; }
+            ListLinks* tail = a;
+            while (tail->next != nullptr) {
+                tail = tail->next;
+            }
+            tail->next = b;
+            return a;
+        }
+        /*
+         * merges two sorted chains joined by next and ending with nullptr,
+         * those of a going first when equal. If comp throws, every node is
+         * left in a, so that none are lost
+         */
+        template <class Compare>
+        static constexpr ListLinks* _merge_chains(ListLinks*& a, ListLinks*& b, Compare& comp) {
+            ListLinks* left = a;
+            ListLinks* right = b;
+            ListLinks* merged = nullptr;
+            ListLinks** tail = &merged;
+            try {
+                while (left != nullptr and right != nullptr) {
+                    if (comp(_value(right), _value(left))) {
+                        *tail = right;
+                        right = right->next;
+                    } else {
+                        *tail = left;
+                        left = left->next;
+                    }
+                    tail = &(*tail)->next;
+                }
+            } catch (...) {
+                *tail = _join_chains(left, right);
+                a = merged;
+                b = nullptr;
+                throw;
+            }
+            *tail = left != nullptr ? left : right;
+            return merged;
+        }
+
+        [[no_unique_address]] NodeAllocator _allocator;
+        // the node past the end, which links to the first and last nodes, or to itself when empty
+        ListLinks _end{&_end, &_end};
+        // kept up to date by every modifier, so size() needn't count the elements
+        std::size_t _size = 0;
     };
 }
 
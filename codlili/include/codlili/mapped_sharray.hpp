@@ -0,0 +1,170 @@
+/*
+ * Created by Joshua Saxby <joshua.a.saxby@gmail.com>, October 2026
+ * Copyright Joshua Saxby <joshua.a.saxby@gmail.com> 2026
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef COM_SAXBOPHONE_CODLILI_MAPPED_SHARRAY_HPP
+#define COM_SAXBOPHONE_CODLILI_MAPPED_SHARRAY_HPP
+
+#if not defined(__unix__) and not defined(__APPLE__)
+#error "codlili/mapped_sharray.hpp is only available on POSIX systems"
+#endif
+
+#include <cerrno>           // errno
+#include <cstddef>          // byte, ptrdiff_t, size_t
+#include <cstring>          // memcpy
+
+#include <filesystem>       // path
+#include <iterator>         // reverse_iterator
+#include <stdexcept>        // out_of_range, runtime_error
+#include <system_error>     // generic_category, system_error
+#include <type_traits>      // is_trivially_copyable_v
+#include <utility>          // exchange
+
+#include <fcntl.h>          // open
+#include <sys/mman.h>       // mmap, munmap
+#include <sys/stat.h>       // fstat
+#include <unistd.h>         // close
+
+#include <codlili/search.hpp>
+#include <codlili/sharray_file.hpp>
+
+
+namespace com::saxbophone::codlili {
+    /**
+     * @brief A read-only view of a file written by `save()`
+     * @details The file is mapped into memory rather than read, so opening
+     * it takes no time regardless of its size, and elements are only read
+     * from disk as they're first accessed. mapped_sharray has the same const
+     * interface as sharray.
+     * @note Only available on POSIX systems.
+     * @warning The elements must not be changed on disk while they're mapped.
+     * @tparam T the type of elements in the file, which must have the same
+     * size and alignment as those it was saved from
+     */
+    template <typename T>
+    requires std::is_trivially_copyable_v<T>
+    class mapped_sharray {
+    public:
+        using value_type = T;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using reference = const T&;
+        using const_reference = const T&;
+        using pointer = const T*;
+        using const_pointer = const T*;
+        using iterator = const T*;
+        using const_iterator = const T*;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+        // member functions
+        /*
+         * maps the file at path.
+         * Throws std::system_error if it can't be opened or mapped, and
+         * std::runtime_error if it isn't a file of elements of T.
+         */
+        explicit mapped_sharray(const std::filesystem::path& path) {
+            int file = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (file == -1) {
+                throw std::system_error(errno, std::generic_category(), "can't open " + path.string());
+            }
+            struct stat status;
+            if (::fstat(file, &status) == -1) {
+                int error = errno;
+                ::close(file);
+                throw std::system_error(error, std::generic_category(), "can't stat " + path.string());
+            }
+            _mapping_size = static_cast<size_type>(status.st_size);
+            if (_mapping_size < sizeof(sharray_file_header)) {
+                ::close(file);
+                throw std::runtime_error(path.string() + " is too short to be a sharray file");
+            }
+            void* mapping = ::mmap(nullptr, _mapping_size, PROT_READ, MAP_PRIVATE, file, 0);
+            // the mapping keeps the file open by itself
+            int error = errno;
+            ::close(file);
+            if (mapping == MAP_FAILED) {
+                throw std::system_error(error, std::generic_category(), "can't map " + path.string());
+            }
+            _mapping = static_cast<const std::byte*>(mapping);
+            sharray_file_header header;
+            std::memcpy(&header, _mapping, sizeof(header));
+            if (not header.describes<T>(_mapping_size)) {
+                _unmap();
+                throw std::runtime_error(path.string() + " is not a sharray file of this element type");
+            }
+            _data = reinterpret_cast<const T*>(_mapping + header.data_offset);
+            _size = static_cast<size_type>(header.size);
+        }
+        mapped_sharray(const mapped_sharray&) = delete;
+        mapped_sharray(mapped_sharray&& other) noexcept
+          : _mapping(std::exchange(other._mapping, nullptr))
+          , _mapping_size(std::exchange(other._mapping_size, 0))
+          , _data(std::exchange(other._data, nullptr))
+          , _size(std::exchange(other._size, 0))
+          {}
+        mapped_sharray& operator=(const mapped_sharray&) = delete;
+        mapped_sharray& operator=(mapped_sharray&& other) noexcept {
+            if (this != &other) {
+                _unmap();
+                _mapping = std::exchange(other._mapping, nullptr);
+                _mapping_size = std::exchange(other._mapping_size, 0);
+                _data = std::exchange(other._data, nullptr);
+                _size = std::exchange(other._size, 0);
+            }
+            return *this;
+        }
+        ~mapped_sharray() { _unmap(); }
+        // element access
+        const_reference at(size_type pos) const {
+            if (pos >= _size) {
+                throw std::out_of_range("mapped_sharray index out of range");
+            }
+            return _data[pos];
+        }
+        const_reference operator[](size_type pos) const { return _data[pos]; }
+        const_reference front() const { return _data[0]; }
+        const_reference back() const { return _data[_size - 1]; }
+        const T* data() const noexcept { return _data; }
+        // iterators
+        const_iterator begin() const noexcept { return _data; }
+        const_iterator cbegin() const noexcept { return begin(); }
+        const_iterator end() const noexcept { return _data + _size; }
+        const_iterator cend() const noexcept { return end(); }
+        const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+        const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+        const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+        const_reverse_iterator crend() const noexcept { return rend(); }
+        // capacity
+        [[nodiscard]] bool empty() const noexcept { return _size == 0; }
+        size_type size() const noexcept { return _size; }
+        // lookup
+        const_iterator find(const T& value) const {
+            return begin() + static_cast<difference_type>(detail::find(_data, _size, value));
+        }
+        size_type count(const T& value) const {
+            return detail::count(_data, _size, value);
+        }
+        bool contains(const T& value) const {
+            return detail::find(_data, _size, value) != _size;
+        }
+    private:
+        void _unmap() noexcept {
+            if (_mapping != nullptr) {
+                ::munmap(const_cast<std::byte*>(_mapping), _mapping_size);
+                _mapping = nullptr;
+            }
+        }
+
+        const std::byte* _mapping = nullptr; // the whole file, including its header
+        size_type _mapping_size = 0;
+        const T* _data = nullptr;
+        size_type _size = 0;
+    };
+}
+
+#endif
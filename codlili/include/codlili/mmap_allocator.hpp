@@ -0,0 +1,151 @@
+/*
+ * Created by Joshua Saxby <joshua.a.saxby@gmail.com>, October 2026
+ * Copyright Joshua Saxby <joshua.a.saxby@gmail.com> 2026
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef COM_SAXBOPHONE_CODLILI_MMAP_ALLOCATOR_HPP
+#define COM_SAXBOPHONE_CODLILI_MMAP_ALLOCATOR_HPP
+
+#ifndef __linux__
+#error "codlili/mmap_allocator.hpp is only available on Linux"
+#endif
+
+#include <cstddef>          // byte, size_t
+
+#include <limits>           // numeric_limits
+#include <new>              // bad_alloc
+#include <type_traits>      // true_type
+
+#include <sys/mman.h>       // madvise, mmap, mremap, munmap
+#include <unistd.h>         // sysconf
+
+
+namespace com::saxbophone::codlili {
+    /**
+     * @brief An allocator which maps memory directly from the kernel, for
+     * very large containers
+     * @details Every allocation is a separate anonymous mapping, rounded up
+     * to a whole number of pages, so this is only worthwhile for allocations
+     * of many pages. Pages aren't backed by physical memory until they're
+     * first written to, so spare capacity which is never used costs only
+     * address space.
+     * sharray recognises this allocator (see `remapping_allocator`) and grows
+     * storage of trivially relocatable elements with `mremap()`, which moves
+     * pages rather than copying their contents, so growing is O(1) in the
+     * number of bytes copied.
+     * @note Only available on Linux.
+     * @tparam T the type of objects to allocate
+     * @tparam HugePages whether to ask the kernel to back allocations with
+     * transparent huge pages (`MADV_HUGEPAGE`), which cuts TLB misses when
+     * scanning large arrays. This is only advice, so is ignored if
+     * transparent huge pages are disabled.
+     */
+    template <typename T, bool HugePages = false>
+    class mmap_allocator {
+    public:
+        using value_type = T;
+        using size_type = std::size_t;
+        using propagate_on_container_move_assignment = std::true_type;
+        using is_always_equal = std::true_type;
+
+        // needed because HugePages stops allocator_traits rebinding automatically
+        template <typename U>
+        struct rebind {
+            using other = mmap_allocator<U, HugePages>;
+        };
+
+        mmap_allocator() noexcept = default;
+        template <typename U>
+        mmap_allocator(const mmap_allocator<U, HugePages>&) noexcept {}
+
+        [[nodiscard]] T* allocate(size_type n) {
+            void* memory = mmap(
+                nullptr, _bytes_for(n), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0
+            );
+            if (memory == MAP_FAILED) { throw std::bad_alloc(); }
+            _advise(memory, _bytes_for(n));
+            return static_cast<T*>(memory);
+        }
+
+        void deallocate(T* p, size_type n) noexcept {
+            // n was already checked for overflow when it was allocated
+            munmap(static_cast<void*>(p), _mapping_bytes(n));
+        }
+
+        /**
+         * @brief Resizes the allocation at p from old_n objects to new_n,
+         * placing what was at p offset objects from the start of the result
+         * @details The contents are moved by remapping pages rather than
+         * copying them, and the memory before the offset is left unmapped
+         * until it's first written to.
+         * @pre `offset * sizeof(T)` must be a multiple of `remap_granularity()`
+         * and `offset + old_n` must not exceed new_n
+         * @returns the new allocation, which p no longer points into
+         * @throws std::bad_alloc if the allocation couldn't be resized, in
+         * which case the allocation at p is left untouched
+         */
+        [[nodiscard]] T* reallocate(T* p, size_type old_n, size_type new_n, size_type offset) {
+            size_type old_bytes = _bytes_for(old_n);
+            size_type new_bytes = _bytes_for(new_n);
+            void* memory;
+            if (offset == 0) {
+                memory = mremap(static_cast<void*>(p), old_bytes, new_bytes, MREMAP_MAYMOVE);
+            } else {
+                // reserve the whole new range, then move the old pages over part of it
+                memory = mmap(
+                    nullptr, new_bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0
+                );
+                if (memory == MAP_FAILED) { throw std::bad_alloc(); }
+                void* target = static_cast<std::byte*>(memory) + offset * sizeof(T);
+                if (mremap(
+                    static_cast<void*>(p), old_bytes, old_bytes, MREMAP_MAYMOVE | MREMAP_FIXED, target
+                ) == MAP_FAILED) {
+                    munmap(memory, new_bytes);
+                    throw std::bad_alloc();
+                }
+            }
+            if (memory == MAP_FAILED) { throw std::bad_alloc(); }
+            _advise(memory, new_bytes);
+            return static_cast<T*>(memory);
+        }
+
+        // the number of bytes which reallocate()'s offset must be a multiple of
+        static size_type remap_granularity() noexcept {
+            return _page_size();
+        }
+
+        friend bool operator==(const mmap_allocator&, const mmap_allocator&) noexcept {
+            return true;
+        }
+
+    private:
+        static size_type _page_size() noexcept {
+            static const size_type page_size = static_cast<size_type>(sysconf(_SC_PAGESIZE));
+            return page_size;
+        }
+        // the size of the mapping needed for n objects, which is never zero
+        static size_type _bytes_for(size_type n) {
+            if (n > (std::numeric_limits<size_type>::max() - _page_size()) / sizeof(T)) {
+                throw std::bad_alloc();
+            }
+            return _mapping_bytes(n);
+        }
+        // as _bytes_for(), for an n known not to overflow
+        static size_type _mapping_bytes(size_type n) noexcept {
+            size_type pages = (n * sizeof(T) + _page_size() - 1) / _page_size();
+            return (pages == 0 ? 1 : pages) * _page_size();
+        }
+        static void _advise([[maybe_unused]] void* memory, [[maybe_unused]] size_type bytes) noexcept {
+            if constexpr (HugePages) {
+                // failing only means the kernel doesn't support them, which is harmless
+                madvise(memory, bytes, MADV_HUGEPAGE);
+            }
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,280 @@
+/*
+ * Created by Joshua Saxby <joshua.a.saxby@gmail.com>, October 2026
+ * Copyright Joshua Saxby <joshua.a.saxby@gmail.com> 2026
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef COM_SAXBOPHONE_CODLILI_NODE_POOL_ALLOCATOR_HPP
+#define COM_SAXBOPHONE_CODLILI_NODE_POOL_ALLOCATOR_HPP
+
+#include <cstddef>          // byte, size_t
+
+#include <memory>           // allocator, allocator_traits
+#include <type_traits>      // false_type, is_constant_evaluated, true_type
+
+
+namespace com::saxbophone::codlili {
+    namespace detail {
+        // a different address for each type, to tell the pools of node_pools apart
+        template <typename T>
+        inline constexpr char node_pool_tag = 0;
+
+        // a pool of objects of one type, in a node_pools
+        template <class Upstream>
+        struct node_pool_base {
+            constexpr explicit node_pool_base(const char* tag) : tag(tag) {}
+            node_pool_base(const node_pool_base&) = delete;
+            node_pool_base& operator=(const node_pool_base&) = delete;
+            constexpr virtual ~node_pool_base() = default;
+            // gives back the pool's slabs and the pool itself to upstream
+            constexpr virtual void release(Upstream& upstream) noexcept = 0;
+
+            const char* tag;
+            node_pool_base* next = nullptr;
+        };
+
+        /*
+         * slabs of SlabSize objects of T, which are handed out one at a time,
+         * and a free list of those which have been given back, to be handed
+         * out again first. The free list is threaded through the slots of the
+         * objects given back, so the only storage is that of the slabs.
+         */
+        template <typename T, std::size_t SlabSize, class Upstream>
+        class node_pool : public node_pool_base<Upstream> {
+        private:
+            union slot {
+                constexpr slot() {}
+                constexpr ~slot() {}
+                T value;
+                slot* next; // the next free slot, once value has been given back
+            };
+            struct slab {
+                constexpr slab() {} // user-provided, so that the slots aren't zeroed
+                slab* next = nullptr;
+                slot slots[SlabSize];
+            };
+            using SlabAllocator = std::allocator_traits<Upstream>::template rebind_alloc<slab>;
+            using SlabTraits = std::allocator_traits<SlabAllocator>;
+            using PoolAllocator = std::allocator_traits<Upstream>::template rebind_alloc<node_pool>;
+            using PoolTraits = std::allocator_traits<PoolAllocator>;
+        public:
+            constexpr node_pool() : node_pool_base<Upstream>(&node_pool_tag<T>) {}
+
+            // creates a pool using storage from upstream
+            static constexpr node_pool* create(Upstream& upstream) {
+                PoolAllocator allocator(upstream);
+                node_pool* pool = PoolTraits::allocate(allocator, 1);
+                PoolTraits::construct(allocator, pool);
+                return pool;
+            }
+            constexpr void release(Upstream& upstream) noexcept override {
+                SlabAllocator slabs(upstream);
+                while (_slabs != nullptr) {
+                    slab* next = _slabs->next;
+                    SlabTraits::destroy(slabs, _slabs);
+                    SlabTraits::deallocate(slabs, _slabs, 1);
+                    _slabs = next;
+                }
+                PoolAllocator allocator(upstream);
+                PoolTraits::destroy(allocator, this);
+                PoolTraits::deallocate(allocator, this, 1);
+            }
+
+            T* allocate(Upstream& upstream) {
+                if (_free != nullptr) {
+                    slot* free = _free;
+                    _free = free->next;
+                    return &free->value;
+                }
+                if (_used == SlabSize) {
+                    SlabAllocator slabs(upstream);
+                    slab* added = SlabTraits::allocate(slabs, 1);
+                    SlabTraits::construct(slabs, added);
+                    added->next = _slabs;
+                    _slabs = added;
+                    _used = 0;
+                }
+                return &_slabs->slots[_used++].value;
+            }
+            void deallocate(T* p) noexcept {
+                // value is the first member of its slot, so they have the same address
+                slot* freed = reinterpret_cast<slot*>(p);
+                freed->next = _free;
+                _free = freed;
+            }
+        private:
+            slab* _slabs = nullptr; // the most recently allocated, which links to the one before
+            slot* _free = nullptr;
+            std::size_t _used = SlabSize; // how many objects have been handed out from the newest slab
+        };
+
+        /*
+         * the storage shared by a node_pool_allocator, its copies and all of
+         * those rebound from it: a pool for each type of object allocated
+         * with them, and the upstream allocator the pools get their storage from
+         */
+        template <std::size_t SlabSize, class Upstream>
+        class node_pools {
+        public:
+            constexpr explicit node_pools(const Upstream& upstream) : _upstream(upstream) {}
+            node_pools(const node_pools&) = delete;
+            node_pools& operator=(const node_pools&) = delete;
+            constexpr ~node_pools() {
+                while (_pools != nullptr) {
+                    node_pool_base<Upstream>* next = _pools->next;
+                    _pools->release(_upstream);
+                    _pools = next;
+                }
+            }
+
+            // the pool for objects of type T, which is created the first time it's needed
+            template <typename T>
+            constexpr node_pool<T, SlabSize, Upstream>* pool() {
+                for (node_pool_base<Upstream>* pool = _pools; pool != nullptr; pool = pool->next) {
+                    if (pool->tag == &node_pool_tag<T>) {
+                        return static_cast<node_pool<T, SlabSize, Upstream>*>(pool);
+                    }
+                }
+                auto created = node_pool<T, SlabSize, Upstream>::create(_upstream);
+                created->next = _pools;
+                _pools = created;
+                return created;
+            }
+            constexpr Upstream& upstream() noexcept { return _upstream; }
+
+            std::size_t references = 1;
+        private:
+            [[no_unique_address]] Upstream _upstream;
+            node_pool_base<Upstream>* _pools = nullptr;
+        };
+    }
+
+    /**
+     * @brief Allocator which hands out single objects from contiguous slabs
+     * @details Meant for node-based containers such as `list`, which allocate
+     * one node at a time. Nodes are carved from slabs of SlabSize nodes
+     * allocated from Upstream, so there's only one allocation per SlabSize
+     * nodes, and nodes allocated one after another are next to each other in
+     * memory. Deallocated nodes go onto a free list, threaded through the
+     * nodes themselves, and are reused before any more are carved. All storage
+     * comes from Upstream, and slabs are only given back to it once every copy
+     * of the allocator, and every allocator rebound from it, has been destroyed.
+     * Allocations of more than one object at a time go straight to Upstream.
+     * @note Copies of a node_pool_allocator, and allocators rebound from it,
+     * share the same pools (one for each type) and compare equal, so nodes
+     * can be spliced between containers built from the same allocator.
+     * The pools aren't thread-safe.
+     * @note It can be used in constant expressions, but as a free node's
+     * storage can't be reused for the free list in them, allocations made
+     * during constant evaluation go straight to Upstream.
+     * @tparam T the type of objects to allocate
+     * @tparam SlabSize how many objects to allocate from Upstream at a time
+     * @tparam Upstream the allocator all storage is allocated with
+     */
+    template <typename T, std::size_t SlabSize = 256, class Upstream = std::allocator<T>>
+    requires (SlabSize > 0)
+    class node_pool_allocator {
+    private:
+        using UpstreamBytes = std::allocator_traits<Upstream>::template rebind_alloc<std::byte>;
+        using Pools = detail::node_pools<SlabSize, UpstreamBytes>;
+        using PoolsAllocator = std::allocator_traits<Upstream>::template rebind_alloc<Pools>;
+        using PoolsTraits = std::allocator_traits<PoolsAllocator>;
+        using UpstreamT = std::allocator_traits<Upstream>::template rebind_alloc<T>;
+        using UpstreamTraits = std::allocator_traits<UpstreamT>;
+    public:
+        using value_type = T;
+        using propagate_on_container_copy_assignment = std::true_type;
+        using propagate_on_container_move_assignment = std::true_type;
+        using propagate_on_container_swap = std::true_type;
+        using is_always_equal = std::false_type;
+        template <typename U>
+        struct rebind {
+            using other = node_pool_allocator<U, SlabSize, Upstream>;
+        };
+
+        constexpr node_pool_allocator() : node_pool_allocator(Upstream()) {}
+        constexpr explicit node_pool_allocator(const Upstream& upstream) {
+            PoolsAllocator allocator(upstream);
+            _pools = PoolsTraits::allocate(allocator, 1);
+            try {
+                PoolsTraits::construct(allocator, _pools, UpstreamBytes(upstream));
+            } catch (...) {
+                PoolsTraits::deallocate(allocator, _pools, 1);
+                throw;
+            }
+        }
+        constexpr node_pool_allocator(const node_pool_allocator& other) noexcept
+          : _pools(other._pools)
+          , _pool(other._pool)
+          {
+            _pools->references++;
+        }
+        // rebound allocators share the same pools, so they compare equal
+        template <typename U>
+        constexpr node_pool_allocator(const node_pool_allocator<U, SlabSize, Upstream>& other) noexcept
+          : _pools(other._pools)
+          {
+            _pools->references++;
+        }
+        constexpr node_pool_allocator& operator=(const node_pool_allocator& other) noexcept {
+            if (_pools != other._pools) {
+                _release();
+                _pools = other._pools;
+                _pools->references++;
+            }
+            _pool = other._pool;
+            return *this;
+        }
+        constexpr ~node_pool_allocator() {
+            _release();
+        }
+
+        [[nodiscard]] constexpr T* allocate(std::size_t n) {
+            if (n != 1 or std::is_constant_evaluated()) {
+                UpstreamT upstream(_pools->upstream());
+                return UpstreamTraits::allocate(upstream, n);
+            }
+            if (_pool == nullptr) {
+                _pool = _pools->template pool<T>();
+            }
+            return _pool->allocate(_pools->upstream());
+        }
+        constexpr void deallocate(T* p, std::size_t n) noexcept {
+            if (n != 1 or std::is_constant_evaluated()) {
+                UpstreamT upstream(_pools->upstream());
+                return UpstreamTraits::deallocate(upstream, p, n);
+            }
+            // a pointer from this pool was allocated by a copy which has already looked it up
+            if (_pool == nullptr) {
+                _pool = _pools->template pool<T>();
+            }
+            _pool->deallocate(p);
+        }
+
+        template <typename U>
+        constexpr bool operator==(const node_pool_allocator<U, SlabSize, Upstream>& other) const noexcept {
+            return _pools == other._pools;
+        }
+    private:
+        template <typename U, std::size_t, class>
+        requires (SlabSize > 0)
+        friend class node_pool_allocator;
+
+        constexpr void _release() noexcept {
+            if (--_pools->references == 0) {
+                // the pools are freed with a copy of their upstream, as that goes with them
+                PoolsAllocator allocator(_pools->upstream());
+                PoolsTraits::destroy(allocator, _pools);
+                PoolsTraits::deallocate(allocator, _pools, 1);
+            }
+        }
+
+        Pools* _pools;
+        detail::node_pool<T, SlabSize, UpstreamBytes>* _pool = nullptr; // looked up on first use
+    };
+}
+
+#endif
@@ -0,0 +1,183 @@
+/*
+ * Created by Joshua Saxby <joshua.a.saxby@gmail.com>, October 2026
+ * Copyright Joshua Saxby <joshua.a.saxby@gmail.com> 2026
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef COM_SAXBOPHONE_CODLILI_RELOCATE_HPP
+#define COM_SAXBOPHONE_CODLILI_RELOCATE_HPP
+
+#include <cstddef>          // size_t
+#include <cstring>          // memcpy, memmove
+
+#include <concepts>         // convertible_to, same_as
+#include <memory>           // allocator_traits
+#include <type_traits>      // is_trivially_copyable, is_nothrow_move_constructible
+#include <utility>          // move_if_noexcept
+
+
+namespace com::saxbophone::codlili {
+    /**
+     * @brief Trait for types which can be relocated by copying their bytes
+     * @details A type is trivially relocatable if moving an object of it to a
+     * new address and then destroying the old object is equivalent to copying
+     * its object representation with `memmove()` and forgetting the old one.
+     * All trivially copyable types are trivially relocatable. Many other types
+     * are too (most `std::string` and `std::vector` implementations, for
+     * instance) but this cannot be detected, so users can opt their own types
+     * in by specialising this trait to derive from `std::true_type`.
+     * @note codlili's containers bypass the allocator's `construct()` and
+     * `destroy()` when relocating types for which this trait is true.
+     */
+    template <typename T>
+    struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
+    template <typename T>
+    inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+    /**
+     * @brief An allocator which can resize an allocation without copying it
+     * @details `allocator.reallocate(p, old_n, new_n, offset)` returns an
+     * allocation of new_n objects holding the bytes of the old_n at p (which
+     * it frees) starting offset objects in, where the size of offset in
+     * bytes must be a multiple of `Allocator::remap_granularity()`. It throws
+     * and leaves p untouched if it fails.
+     * @note codlili's containers use this to grow storage of trivially
+     * relocatable elements (see `mmap_allocator`).
+     */
+    template <class Allocator>
+    concept remapping_allocator = requires (
+        Allocator& allocator, typename Allocator::value_type* p, std::size_t n
+    ) {
+        { allocator.reallocate(p, n, n, n) } -> std::same_as<typename Allocator::value_type*>;
+        { Allocator::remap_granularity() } -> std::convertible_to<std::size_t>;
+    };
+
+    namespace detail {
+        // can elements of T be relocated without any chance of an exception?
+        template <typename T>
+        inline constexpr bool is_nothrow_relocatable_v =
+            is_trivially_relocatable_v<T> or std::is_nothrow_move_constructible_v<T>;
+
+        // destroys count objects starting at first
+        template <class Allocator, typename T>
+        constexpr void destroy(Allocator& allocator, T* first, std::size_t count) noexcept {
+            for (std::size_t i = 0; i < count; i++) {
+                std::allocator_traits<Allocator>::destroy(allocator, first + i);
+            }
+        }
+
+        /*
+         * constructs count objects in the uninitialised storage starting at
+         * destination from those starting at source, moving them if this can't
+         * throw, otherwise copying them. If a copy throws, all newly-constructed
+         * objects are destroyed and the source range is left untouched.
+         */
+        template <class Allocator, typename T>
+        constexpr void uninitialized_move_if_noexcept(
+            Allocator& allocator,
+            T* source,
+            std::size_t count,
+            T* destination
+        ) {
+            std::size_t constructed = 0;
+            try {
+                for (; constructed < count; constructed++) {
+                    std::allocator_traits<Allocator>::construct(
+                        allocator,
+                        destination + constructed,
+                        std::move_if_noexcept(source[constructed])
+                    );
+                }
+            } catch (...) {
+                destroy(allocator, destination, constructed);
+                throw;
+            }
+        }
+
+        /*
+         * relocates count objects starting at source to the uninitialised
+         * storage starting at destination, leaving the source storage
+         * uninitialised afterwards. The two ranges must not overlap.
+         * Elements are moved if they can be without throwing, otherwise copied.
+         * If a copy throws, all newly-constructed objects are destroyed and
+         * the source range is left untouched.
+         */
+        template <class Allocator, typename T>
+        constexpr void relocate(
+            Allocator& allocator,
+            T* source,
+            std::size_t count,
+            T* destination
+        ) {
+            using Traits = std::allocator_traits<Allocator>;
+            if (count == 0) { return; }
+            if constexpr (is_trivially_relocatable_v<T>) {
+                if (not std::is_constant_evaluated()) {
+                    // the whole block can be moved in one go
+                    std::memcpy(
+                        static_cast<void*>(destination),
+                        static_cast<const void*>(source),
+                        count * sizeof(T)
+                    );
+                    return;
+                }
+            }
+            if constexpr (is_nothrow_relocatable_v<T>) {
+                // nothing can throw, so relocate one element at a time
+                for (std::size_t i = 0; i < count; i++) {
+                    Traits::construct(allocator, destination + i, std::move(source[i]));
+                    Traits::destroy(allocator, source + i);
+                }
+            } else {
+                // copy everything across first so a throwing copy can be undone
+                uninitialized_move_if_noexcept(allocator, source, count, destination);
+                destroy(allocator, source, count);
+            }
+        }
+
+        /*
+         * like relocate(), but for moving objects around within the same block
+         * of storage, so the source and destination ranges may overlap.
+         * Only available for nothrow-relocatable types, as there is no way to
+         * roll back a partially-completed overlapping relocation.
+         */
+        template <class Allocator, typename T>
+        requires is_nothrow_relocatable_v<T>
+        constexpr void shift(
+            Allocator& allocator,
+            T* source,
+            std::size_t count,
+            T* destination
+        ) noexcept {
+            using Traits = std::allocator_traits<Allocator>;
+            if (count == 0 or source == destination) { return; }
+            if constexpr (is_trivially_relocatable_v<T>) {
+                if (not std::is_constant_evaluated()) {
+                    std::memmove(
+                        static_cast<void*>(destination),
+                        static_cast<const void*>(source),
+                        count * sizeof(T)
+                    );
+                    return;
+                }
+            }
+            if (destination < source) { // ascending order, safe for overlap
+                for (std::size_t i = 0; i < count; i++) {
+                    Traits::construct(allocator, destination + i, std::move(source[i]));
+                    Traits::destroy(allocator, source + i);
+                }
+            } else { // descending order, safe for overlap
+                for (std::size_t i = count; i-- > 0; ) {
+                    Traits::construct(allocator, destination + i, std::move(source[i]));
+                    Traits::destroy(allocator, source + i);
+                }
+            }
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,588 @@
+/*
+ * Created by Joshua Saxby <joshua.a.saxby@gmail.com>, October 2026
+ * Copyright Joshua Saxby <joshua.a.saxby@gmail.com> 2026
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef COM_SAXBOPHONE_CODLILI_RING_SHARRAY_HPP
+#define COM_SAXBOPHONE_CODLILI_RING_SHARRAY_HPP
+
+#include <cstddef>          // ptrdiff_t, size_t
+
+#include <algorithm>        // equal, lexicographical_compare_three_way, min
+#include <compare>          // three_way_comparable
+#include <initializer_list> // initializer_list
+#include <iterator>         // input_iterator, make_move_iterator, random_access_iterator_tag, reverse_iterator
+#include <limits>           // numeric_limits
+#include <memory>           // allocator, allocator_traits
+#include <span>             // span
+#include <stdexcept>        // out_of_range
+#include <type_traits>      // conditional_t
+#include <utility>          // exchange, forward, move, pair, swap
+
+#include <codlili/growth_policy.hpp>
+#include <codlili/relocate.hpp>
+#include <codlili/search.hpp>
+
+
+namespace com::saxbophone::codlili {
+    namespace detail {
+        /*
+         * iterator of ring_sharray, which refers to an element by its
+         * position counted from the start of the storage without wrapping
+         * around, so positions past the end of the storage are wrapped back
+         * round to the start when dereferenced
+         */
+        template <typename T, bool Const>
+        class ring_iterator {
+        public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = std::conditional_t<Const, const T*, T*>;
+            using reference = std::conditional_t<Const, const T&, T&>;
+
+            constexpr ring_iterator() = default;
+            constexpr ring_iterator(T* data, std::size_t capacity, std::size_t position)
+              : _data(data)
+              , _capacity(capacity)
+              , _position(position)
+              {}
+            constexpr ring_iterator(const ring_iterator&) = default;
+            constexpr ring_iterator& operator=(const ring_iterator&) = default;
+            // iterator converts to const_iterator
+            constexpr ring_iterator(const ring_iterator<T, false>& other) requires Const
+              : _data(other._data)
+              , _capacity(other._capacity)
+              , _position(other._position)
+              {}
+
+            constexpr reference operator*() const {
+                return _data[_position < _capacity ? _position : _position - _capacity];
+            }
+            constexpr pointer operator->() const { return &**this; }
+            constexpr reference operator[](difference_type n) const { return *(*this + n); }
+
+            constexpr ring_iterator& operator++() { _position++; return *this; }
+            constexpr ring_iterator operator++(int) { auto old = *this; ++*this; return old; }
+            constexpr ring_iterator& operator--() { _position--; return *this; }
+            constexpr ring_iterator operator--(int) { auto old = *this; --*this; return old; }
+            // unsigned arithmetic wraps around, so adding a negative offset works too
+            constexpr ring_iterator& operator+=(difference_type n) {
+                _position += static_cast<std::size_t>(n);
+                return *this;
+            }
+            constexpr ring_iterator& operator-=(difference_type n) {
+                _position -= static_cast<std::size_t>(n);
+                return *this;
+            }
+            friend constexpr ring_iterator operator+(ring_iterator it, difference_type n) { return it += n; }
+            friend constexpr ring_iterator operator+(difference_type n, ring_iterator it) { return it += n; }
+            friend constexpr ring_iterator operator-(ring_iterator it, difference_type n) { return it -= n; }
+            friend constexpr difference_type operator-(const ring_iterator& lhs, const ring_iterator& rhs) {
+                return static_cast<difference_type>(lhs._position - rhs._position);
+            }
+            friend constexpr bool operator==(const ring_iterator& lhs, const ring_iterator& rhs) {
+                return lhs._position == rhs._position;
+            }
+            friend constexpr auto operator<=>(const ring_iterator& lhs, const ring_iterator& rhs) {
+                return lhs._position <=> rhs._position;
+            }
+        private:
+            template <typename, bool>
+            friend class ring_iterator;
+
+            T* _data = nullptr;
+            std::size_t _capacity = 0;
+            std::size_t _position = 0;
+        };
+    }
+
+    /**
+     * @brief A sharray whose elements wrap around the end of its storage
+     * @details ring_sharray is a circular buffer: when the elements reach the
+     * end of the storage they carry on from its start, and vice versa. So
+     * unlike sharray, which has to slide its elements along or reallocate
+     * once they've drifted to one end of its storage, ring_sharray never
+     * moves any elements to push or pop at either end, and never allocates
+     * unless it's completely full. A queue which is pushed at one end and
+     * popped at the other stops allocating once it's reached its largest
+     * size.
+     * `try_push_back()` and friends never allocate at all, for using
+     * ring_sharray as a bounded queue, and `spans()` gives the elements as
+     * (at most) two contiguous runs, for vectored I/O such as `writev()`.
+     * @note Elements can only be inserted and erased at the ends.
+     * @tparam T the type of elements to store
+     * @tparam Allocator the allocator to use for storage
+     * @tparam GrowthPolicy decides how much storage to allocate when full
+     */
+    template <
+        typename T,
+        class Allocator = std::allocator<T>,
+        growth_policy GrowthPolicy = default_growth
+    >
+    class ring_sharray {
+    private:
+        using TAllocator = std::allocator_traits<Allocator>::template rebind_traits<T>;
+    public:
+        using value_type = T;
+        using allocator_type = Allocator;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using reference = T&;
+        using const_reference = const T&;
+        using pointer = typename std::allocator_traits<Allocator>::pointer;
+        using const_pointer = typename std::allocator_traits<Allocator>::const_pointer;
+        using iterator = detail::ring_iterator<T, false>;
+        using const_iterator = detail::ring_iterator<T, true>;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+        // member functions
+        constexpr ring_sharray() noexcept(noexcept(Allocator())) {}
+        constexpr explicit ring_sharray(const Allocator& alloc) noexcept
+          : _allocator(alloc)
+          {}
+
+        constexpr ring_sharray(
+            size_type count,
+            const T& value,
+            const Allocator& alloc = Allocator()
+        )
+          : ring_sharray(alloc) // delegated, so the destructor cleans up if this throws
+          {
+            resize(count, value);
+        }
+
+        constexpr explicit ring_sharray(
+            size_type count, const Allocator& alloc = Allocator()
+        )
+          : ring_sharray(alloc)
+          {
+            resize(count);
+        }
+
+        template<std::input_iterator InputIt>
+        constexpr ring_sharray(
+            InputIt first, InputIt last, const Allocator& alloc = Allocator()
+        )
+          : ring_sharray(alloc)
+          {
+            _append(first, last);
+        }
+
+        constexpr ring_sharray(const ring_sharray& other)
+          : ring_sharray(
+                other,
+                TAllocator::select_on_container_copy_construction(other._allocator)
+            )
+          {}
+
+        constexpr ring_sharray(const ring_sharray& other, const Allocator& alloc)
+          : ring_sharray(alloc)
+          {
+            _append(other.begin(), other.end());
+        }
+
+        constexpr ring_sharray(ring_sharray&& other) noexcept
+          : _allocator(std::move(other._allocator))
+          {
+            _take_storage(other);
+        }
+
+        constexpr ring_sharray(ring_sharray&& other, const Allocator& alloc)
+          : ring_sharray(alloc)
+          {
+            if (_allocator == other._allocator) {
+                _take_storage(other);
+                return;
+            }
+            // other's storage can't be freed with our allocator, so its elements are moved individually
+            _append(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+        }
+
+        constexpr ring_sharray(
+            std::initializer_list<T> init, const Allocator& alloc = Allocator()
+        )
+          : ring_sharray(init.begin(), init.end(), alloc)
+          {}
+
+        constexpr ~ring_sharray() {
+            _release_storage();
+        }
+
+        constexpr ring_sharray& operator=(const ring_sharray& other) {
+            if (this == &other) { return *this; }
+            if constexpr (TAllocator::propagate_on_container_copy_assignment::value) {
+                if (_allocator != other._allocator) {
+                    // our storage can't be kept, as the allocator it came from is being replaced
+                    _release_storage();
+                }
+                _allocator = other._allocator;
+            }
+            assign(other.begin(), other.end());
+            return *this;
+        }
+        constexpr ring_sharray& operator=(ring_sharray&& other) noexcept(
+            TAllocator::propagate_on_container_move_assignment::value or
+            TAllocator::is_always_equal::value
+        ) {
+            if (this == &other) { return *this; }
+            if constexpr (TAllocator::propagate_on_container_move_assignment::value) {
+                _release_storage();
+                _allocator = other._allocator;
+            } else if (_allocator != other._allocator) {
+                // we can't take ownership of other's storage, so must move each element individually
+                assign(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+                return *this;
+            } else {
+                _release_storage();
+            }
+            _take_storage(other);
+            return *this;
+        }
+        constexpr ring_sharray& operator=(std::initializer_list<T> ilist) {
+            assign(ilist);
+            return *this;
+        }
+        constexpr void assign(size_type count, const T& value) {
+            clear();
+            resize(count, value);
+        }
+        template<std::input_iterator InputIt>
+        constexpr void assign(InputIt first, InputIt last) {
+            clear();
+            _append(first, last);
+        }
+        constexpr void assign(std::initializer_list<T> ilist) {
+            assign(ilist.begin(), ilist.end());
+        }
+        constexpr allocator_type get_allocator() const noexcept { return _allocator; }
+        // element access
+        constexpr reference at(size_type pos) {
+            if (pos >= _size) {
+                throw std::out_of_range("ring_sharray index out of range");
+            }
+            return (*this)[pos];
+        }
+        constexpr const_reference at(size_type pos) const {
+            if (pos >= _size) {
+                throw std::out_of_range("ring_sharray index out of range");
+            }
+            return (*this)[pos];
+        }
+        constexpr reference operator[](size_type pos) { return *_slot(pos); }
+        constexpr const_reference operator[](size_type pos) const { return *_slot(pos); }
+        constexpr reference front() { return *_slot(0); }
+        constexpr const_reference front() const { return *_slot(0); }
+        constexpr reference back() { return *_slot(_size - 1); }
+        constexpr const_reference back() const { return *_slot(_size - 1); }
+        /*
+         * the elements as two contiguous runs, the first of which holds the
+         * first elements up to the end of the storage, and the second the
+         * rest from the start of the storage (which is empty unless the
+         * elements wrap around)
+         */
+        constexpr std::pair<std::span<T>, std::span<T>> spans() noexcept {
+            size_type first = std::min(_size, _capacity - _head);
+            return {{_data + _head, first}, {_data, _size - first}};
+        }
+        constexpr std::pair<std::span<const T>, std::span<const T>> spans() const noexcept {
+            size_type first = std::min(_size, _capacity - _head);
+            return {{_data + _head, first}, {_data, _size - first}};
+        }
+        // iterators
+        constexpr iterator begin() noexcept { return {_data, _capacity, _head}; }
+        constexpr const_iterator begin() const noexcept { return {_data, _capacity, _head}; }
+        constexpr const_iterator cbegin() const noexcept { return begin(); }
+        constexpr iterator end() noexcept { return {_data, _capacity, _head + _size}; }
+        constexpr const_iterator end() const noexcept { return {_data, _capacity, _head + _size}; }
+        constexpr const_iterator cend() const noexcept { return end(); }
+        constexpr reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+        constexpr const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+        constexpr const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+        constexpr reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+        constexpr const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+        constexpr const_reverse_iterator crend() const noexcept { return rend(); }
+        // capacity
+        [[nodiscard]] constexpr bool empty() const noexcept { return _size == 0; }
+        [[nodiscard]] constexpr bool full() const noexcept { return _size == _capacity; }
+        constexpr size_type size() const noexcept { return _size; }
+        constexpr size_type max_size() const noexcept {
+            return std::numeric_limits<difference_type>::max();
+        }
+        // storage is allocated for exactly new_cap elements, if that's more than there is
+        constexpr void reserve(size_type new_cap) {
+            if (new_cap > _capacity) {
+                _reallocate(new_cap);
+            }
+        }
+        constexpr size_type capacity() const noexcept { return _capacity; }
+        constexpr void shrink_to_fit() {
+            if (_size == 0) {
+                _release_storage();
+            } else if (_size < _capacity) {
+                _reallocate(_size);
+            }
+        }
+        // modifiers
+        // keeps the storage, so a cleared ring_sharray can be refilled without allocating
+        constexpr void clear() noexcept {
+            while (_size != 0) {
+                pop_back();
+            }
+            _head = 0;
+        }
+        constexpr void push_back(const T& value) {
+            emplace_back(value);
+        }
+        constexpr void push_back(T&& value) {
+            emplace_back(std::move(value));
+        }
+        template<class... Args>
+        constexpr reference emplace_back(Args&&... args) {
+            if (full()) {
+                _grow(_size, std::forward<Args>(args)...);
+            } else {
+                TAllocator::construct(_allocator, _slot(_size), std::forward<Args>(args)...);
+            }
+            _size++;
+            return back();
+        }
+        constexpr void pop_back() {
+            _size--;
+            TAllocator::destroy(_allocator, _slot(_size));
+        }
+        constexpr void push_front(const T& value) {
+            emplace_front(value);
+        }
+        constexpr void push_front(T&& value) {
+            emplace_front(std::move(value));
+        }
+        template<class... Args>
+        constexpr reference emplace_front(Args&&... args) {
+            if (full()) {
+                // the new element goes last in the new storage, before the others wrap round to its start
+                _grow(0, std::forward<Args>(args)...);
+            } else {
+                size_type head = (_head == 0 ? _capacity : _head) - 1;
+                TAllocator::construct(_allocator, _data + head, std::forward<Args>(args)...);
+                _head = head;
+            }
+            _size++;
+            return front();
+        }
+        constexpr void pop_front() {
+            TAllocator::destroy(_allocator, _data + _head);
+            _head = _head + 1 == _capacity ? 0 : _head + 1;
+            _size--;
+        }
+        // like push_back(), but returns false instead of allocating if full
+        constexpr bool try_push_back(const T& value) {
+            return try_emplace_back(value);
+        }
+        constexpr bool try_push_back(T&& value) {
+            return try_emplace_back(std::move(value));
+        }
+        template<class... Args>
+        constexpr bool try_emplace_back(Args&&... args) {
+            if (full()) { return false; }
+            emplace_back(std::forward<Args>(args)...);
+            return true;
+        }
+        // like push_front(), but returns false instead of allocating if full
+        constexpr bool try_push_front(const T& value) {
+            return try_emplace_front(value);
+        }
+        constexpr bool try_push_front(T&& value) {
+            return try_emplace_front(std::move(value));
+        }
+        template<class... Args>
+        constexpr bool try_emplace_front(Args&&... args) {
+            if (full()) { return false; }
+            emplace_front(std::forward<Args>(args)...);
+            return true;
+        }
+        constexpr void resize(size_type count) {
+            while (_size > count) {
+                pop_back();
+            }
+            reserve(count);
+            while (_size < count) {
+                emplace_back();
+            }
+        }
+        constexpr void resize(size_type count, const value_type& value) {
+            while (_size > count) {
+                pop_back();
+            }
+            if (count > _capacity) {
+                // value may be one of our elements, which reallocating would move
+                const value_type copy = value;
+                reserve(count);
+                while (_size < count) {
+                    emplace_back(copy);
+                }
+            }
+            while (_size < count) {
+                emplace_back(value);
+            }
+        }
+        constexpr void swap(ring_sharray& other) noexcept {
+            if constexpr (TAllocator::propagate_on_container_swap::value) {
+                std::swap(_allocator, other._allocator);
+            }
+            std::swap(_data, other._data);
+            std::swap(_capacity, other._capacity);
+            std::swap(_head, other._head);
+            std::swap(_size, other._size);
+        }
+        // lookup
+        // iterator to the first element equal to value, or end() if there isn't one
+        constexpr iterator find(const T& value) {
+            return begin() + static_cast<difference_type>(_find(value));
+        }
+        constexpr const_iterator find(const T& value) const {
+            return begin() + static_cast<difference_type>(_find(value));
+        }
+        constexpr size_type count(const T& value) const {
+            auto [first, second] = spans();
+            return detail::count(first.data(), first.size(), value)
+                + detail::count(second.data(), second.size(), value);
+        }
+        constexpr bool contains(const T& value) const {
+            return _find(value) != _size;
+        }
+        // comparison
+        constexpr bool operator==(const ring_sharray& other) const {
+            return _size == other._size and std::equal(begin(), end(), other.begin());
+        }
+        constexpr auto operator<=>(const ring_sharray& other) const
+        requires std::three_way_comparable<T> {
+            return std::lexicographical_compare_three_way(
+                begin(), end(), other.begin(), other.end()
+            );
+        }
+    private:
+        // the storage for the element at index
+        constexpr T* _slot(size_type index) const {
+            size_type position = _head + index;
+            return _data + (position < _capacity ? position : position - _capacity);
+        }
+        // index of the first element equal to value, or _size if there isn't one
+        constexpr size_type _find(const T& value) const {
+            auto [first, second] = spans();
+            size_type index = detail::find(first.data(), first.size(), value);
+            if (index != first.size()) { return index; }
+            return first.size() + detail::find(second.data(), second.size(), value);
+        }
+        template <std::input_iterator InputIt>
+        constexpr void _append(InputIt first, InputIt last) {
+            if constexpr (std::forward_iterator<InputIt>) {
+                reserve(_size + static_cast<size_type>(std::distance(first, last)));
+            }
+            for (; first != last; ++first) {
+                emplace_back(*first);
+            }
+        }
+        /*
+         * moves the elements into new storage for new_cap elements, with the
+         * first at its start, so they don't wrap around
+         */
+        constexpr void _reallocate(size_type new_cap) {
+            T* data = TAllocator::allocate(_allocator, new_cap);
+            try {
+                _move_elements_to(data);
+            } catch (...) {
+                TAllocator::deallocate(_allocator, data, new_cap);
+                throw;
+            }
+            _replace_storage(data, new_cap);
+        }
+        /*
+         * moves the elements into larger storage, leaving room before the
+         * element at index for a new one constructed from args. The new
+         * element is constructed first, as args may refer to an element.
+         */
+        template <class... Args>
+        constexpr void _grow(size_type index, Args&&... args) {
+            size_type new_cap = GrowthPolicy::capacity_for(_size + 1, _capacity);
+            T* data = TAllocator::allocate(_allocator, new_cap);
+            // pushing at the front puts the new element at the end, so the rest needn't be shifted
+            T* element = data + (index == 0 ? new_cap - 1 : index);
+            try {
+                TAllocator::construct(_allocator, element, std::forward<Args>(args)...);
+            } catch (...) {
+                TAllocator::deallocate(_allocator, data, new_cap);
+                throw;
+            }
+            try {
+                _move_elements_to(data);
+            } catch (...) {
+                TAllocator::destroy(_allocator, element);
+                TAllocator::deallocate(_allocator, data, new_cap);
+                throw;
+            }
+            _replace_storage(data, new_cap);
+            if (index == 0) {
+                _head = new_cap - 1;
+            }
+        }
+        // relocates the elements, in order, to destination, leaving them where they were if this throws
+        constexpr void _move_elements_to(T* destination) {
+            auto [front, back] = spans();
+            if constexpr (detail::is_nothrow_relocatable_v<T>) {
+                detail::relocate(_allocator, front.data(), front.size(), destination);
+                detail::relocate(_allocator, back.data(), back.size(), destination + front.size());
+            } else {
+                // copy everything before destroying anything, so a throwing copy can be undone
+                detail::uninitialized_move_if_noexcept(_allocator, front.data(), front.size(), destination);
+                try {
+                    detail::uninitialized_move_if_noexcept(
+                        _allocator, back.data(), back.size(), destination + front.size()
+                    );
+                } catch (...) {
+                    detail::destroy(_allocator, destination, front.size());
+                    throw;
+                }
+                detail::destroy(_allocator, front.data(), front.size());
+                detail::destroy(_allocator, back.data(), back.size());
+            }
+        }
+        // frees our storage (whose elements must have been relocated) and uses data instead
+        constexpr void _replace_storage(T* data, size_type capacity) {
+            if (_data != nullptr) {
+                TAllocator::deallocate(_allocator, _data, _capacity);
+            }
+            _data = data;
+            _capacity = capacity;
+            _head = 0;
+        }
+        // destroys all elements and frees the storage
+        constexpr void _release_storage() noexcept {
+            clear();
+            if (_data != nullptr) {
+                TAllocator::deallocate(_allocator, _data, _capacity);
+            }
+            _data = nullptr;
+            _capacity = 0;
+        }
+        // takes other's storage, which must have come from an allocator equal to ours
+        constexpr void _take_storage(ring_sharray& other) noexcept {
+            _data = std::exchange(other._data, nullptr);
+            _capacity = std::exchange(other._capacity, 0);
+            _head = std::exchange(other._head, 0);
+            _size = std::exchange(other._size, 0);
+        }
+
+        T* _data = nullptr;
+        size_type _capacity = 0;
+        size_type _head = 0; // index within the storage of the first element
+        size_type _size = 0;
+        [[no_unique_address]] Allocator _allocator;
+    };
+}
+
+#endif
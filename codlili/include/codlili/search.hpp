@@ -0,0 +1,338 @@
+/*
+ * Created by Joshua Saxby <joshua.a.saxby@gmail.com>, October 2026
+ * Copyright Joshua Saxby <joshua.a.saxby@gmail.com> 2026
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef COM_SAXBOPHONE_CODLILI_SEARCH_HPP
+#define COM_SAXBOPHONE_CODLILI_SEARCH_HPP
+
+#include <cstddef>          // byte, size_t
+#include <cstdint>          // uint8_t, uint16_t, uint32_t, uint64_t
+#include <cstring>          // memcpy
+
+#include <bit>              // countr_zero, popcount
+#include <iterator>         // random_access_iterator
+#include <type_traits>      // bool_constant, is_constant_evaluated, is_enum_v, is_integral_v, is_pointer_v, is_same_v, is_unsigned_v
+
+#if (defined(__x86_64__) or defined(__i386__)) and defined(__GNUC__) and defined(__SSE2__)
+#define COM_SAXBOPHONE_CODLILI_X86_SIMD
+#include <immintrin.h>
+#endif
+
+
+namespace com::saxbophone::codlili {
+    /**
+     * @brief Trait for types whose objects are equal exactly when their bytes are
+     * @details This holds for integers, enums and pointers, but not floating
+     * point types (`0.0 == -0.0`, and NaN isn't equal to itself), or most
+     * classes. Users can opt their own types in by specialising this trait
+     * to derive from `std::true_type`.
+     * @note codlili's containers compare these types with `memcmp()` and
+     * search them with SIMD instructions where available.
+     */
+    template <typename T>
+    struct is_trivially_equality_comparable : std::bool_constant<
+        std::is_integral_v<T> or std::is_enum_v<T> or std::is_pointer_v<T>
+    > {};
+
+    template <typename T>
+    inline constexpr bool is_trivially_equality_comparable_v = is_trivially_equality_comparable<T>::value;
+
+    namespace detail {
+        // is T a type of byte, whose values are ordered the same way memcmp() orders them?
+        template <typename T>
+        inline constexpr bool is_byte_v =
+            std::is_same_v<T, unsigned char> or std::is_same_v<T, std::byte> or
+            std::is_same_v<T, char8_t> or std::is_same_v<T, bool> or
+            (std::is_same_v<T, char> and std::is_unsigned_v<char>);
+
+        // instruction sets which searches can be done with
+        enum class simd_level { SCALAR, SSE2, AVX2, };
+
+        // the best instruction set supported by the CPU we're running on
+        inline simd_level detect_simd_level() {
+#ifdef COM_SAXBOPHONE_CODLILI_X86_SIMD
+            static const simd_level level = [] {
+                __builtin_cpu_init();
+                return __builtin_cpu_supports("avx2") ? simd_level::AVX2 : simd_level::SSE2;
+            }();
+            return level;
+#else
+            return simd_level::SCALAR;
+#endif
+        }
+
+        // index of the first element of data equal to value, or size if there isn't one
+        template <typename T>
+        constexpr std::size_t find_scalar(const T* data, std::size_t size, const T& value) {
+            for (std::size_t i = 0; i < size; i++) {
+                if (data[i] == value) { return i; }
+            }
+            return size;
+        }
+
+        // how many elements of data are equal to value
+        template <typename T>
+        constexpr std::size_t count_scalar(const T* data, std::size_t size, const T& value) {
+            std::size_t count = 0;
+            for (std::size_t i = 0; i < size; i++) {
+                if (data[i] == value) { count++; }
+            }
+            return count;
+        }
+
+        // can find() and count() use SIMD instructions for T?
+        template <typename T>
+        inline constexpr bool is_simd_searchable_v = is_trivially_equality_comparable_v<T> and (
+            sizeof(T) == 1 or sizeof(T) == 2 or sizeof(T) == 4 or sizeof(T) == 8
+        );
+
+#ifdef COM_SAXBOPHONE_CODLILI_X86_SIMD
+        // a vector register filled with copies of the object representation of value
+        template <typename T>
+        inline __m128i broadcast_sse2(const T& value) {
+            if constexpr (sizeof(T) == 1) {
+                std::uint8_t bits;
+                std::memcpy(&bits, &value, sizeof(T));
+                return _mm_set1_epi8(static_cast<char>(bits));
+            } else if constexpr (sizeof(T) == 2) {
+                std::uint16_t bits;
+                std::memcpy(&bits, &value, sizeof(T));
+                return _mm_set1_epi16(static_cast<short>(bits));
+            } else if constexpr (sizeof(T) == 4) {
+                std::uint32_t bits;
+                std::memcpy(&bits, &value, sizeof(T));
+                return _mm_set1_epi32(static_cast<int>(bits));
+            } else {
+                std::uint64_t bits;
+                std::memcpy(&bits, &value, sizeof(T));
+                return _mm_set1_epi64x(static_cast<long long>(bits));
+            }
+        }
+
+        /*
+         * compares the 16 bytes at data with needle an element at a time,
+         * setting all the bytes of each element that matched
+         */
+        template <typename T>
+        inline __m128i compare_sse2(const T* data, __m128i needle) {
+            __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+            if constexpr (sizeof(T) == 1) {
+                return _mm_cmpeq_epi8(block, needle);
+            } else if constexpr (sizeof(T) == 2) {
+                return _mm_cmpeq_epi16(block, needle);
+            } else if constexpr (sizeof(T) == 4) {
+                return _mm_cmpeq_epi32(block, needle);
+            } else {
+                // SSE2 can't compare 64-bit lanes, so both halves of each must match
+                __m128i halves = _mm_cmpeq_epi32(block, needle);
+                return _mm_and_si128(halves, _mm_shuffle_epi32(halves, _MM_SHUFFLE(2, 3, 0, 1)));
+            }
+        }
+
+        template <typename T>
+        [[gnu::target("avx2")]] inline __m256i compare_avx2(const T* data, __m256i needle) {
+            __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+            if constexpr (sizeof(T) == 1) {
+                return _mm256_cmpeq_epi8(block, needle);
+            } else if constexpr (sizeof(T) == 2) {
+                return _mm256_cmpeq_epi16(block, needle);
+            } else if constexpr (sizeof(T) == 4) {
+                return _mm256_cmpeq_epi32(block, needle);
+            } else {
+                return _mm256_cmpeq_epi64(block, needle);
+            }
+        }
+
+        /*
+         * Searches take a bitmask of which bytes matched from each comparison,
+         * which has sizeof(T) bits set for each matching element.
+         * Counts instead add up the matching bytes in a vector of byte-sized
+         * counters, flushed before they can overflow.
+         */
+        template <typename T>
+        std::size_t find_sse2(const T* data, std::size_t size, const T& value) {
+            constexpr std::size_t STRIDE = 16 / sizeof(T);
+            __m128i needle = broadcast_sse2(value);
+            std::size_t i = 0;
+            for (; i + STRIDE <= size; i += STRIDE) {
+                if (int matches = _mm_movemask_epi8(compare_sse2(data + i, needle))) {
+                    auto byte = static_cast<std::size_t>(std::countr_zero(static_cast<unsigned>(matches)));
+                    return i + byte / sizeof(T);
+                }
+            }
+            return i + find_scalar(data + i, size - i, value);
+        }
+
+        template <typename T>
+        std::size_t count_sse2(const T* data, std::size_t size, const T& value) {
+            constexpr std::size_t STRIDE = 16 / sizeof(T);
+            constexpr std::size_t MAX_ROUNDS = 255; // before the byte counters overflow
+            __m128i needle = broadcast_sse2(value);
+            std::size_t matched_bytes = 0;
+            std::size_t i = 0;
+            while (i + STRIDE <= size) {
+                __m128i counters = _mm_setzero_si128();
+                for (std::size_t round = 0; round < MAX_ROUNDS and i + STRIDE <= size; round++, i += STRIDE) {
+                    // matching bytes are all ones, i.e. -1
+                    counters = _mm_sub_epi8(counters, compare_sse2(data + i, needle));
+                }
+                __m128i sums = _mm_sad_epu8(counters, _mm_setzero_si128());
+                matched_bytes += static_cast<std::size_t>(_mm_cvtsi128_si32(sums));
+                matched_bytes += static_cast<std::size_t>(_mm_cvtsi128_si32(_mm_unpackhi_epi64(sums, sums)));
+            }
+            return matched_bytes / sizeof(T) + count_scalar(data + i, size - i, value);
+        }
+
+        template <typename T>
+        [[gnu::target("avx2")]] std::size_t find_avx2(const T* data, std::size_t size, const T& value) {
+            constexpr std::size_t STRIDE = 32 / sizeof(T);
+            __m256i needle = _mm256_broadcastsi128_si256(broadcast_sse2(value));
+            std::size_t i = 0;
+            for (; i + STRIDE <= size; i += STRIDE) {
+                if (int matches = _mm256_movemask_epi8(compare_avx2(data + i, needle))) {
+                    auto byte = static_cast<std::size_t>(std::countr_zero(static_cast<unsigned>(matches)));
+                    return i + byte / sizeof(T);
+                }
+            }
+            // finish off with at most one narrower comparison, then one at a time
+            return i + find_sse2(data + i, size - i, value);
+        }
+
+        template <typename T>
+        [[gnu::target("avx2")]] std::size_t count_avx2(const T* data, std::size_t size, const T& value) {
+            constexpr std::size_t STRIDE = 32 / sizeof(T);
+            constexpr std::size_t MAX_ROUNDS = 255;
+            __m256i needle = _mm256_broadcastsi128_si256(broadcast_sse2(value));
+            std::size_t matched_bytes = 0;
+            std::size_t i = 0;
+            while (i + STRIDE <= size) {
+                __m256i counters = _mm256_setzero_si256();
+                for (std::size_t round = 0; round < MAX_ROUNDS and i + STRIDE <= size; round++, i += STRIDE) {
+                    counters = _mm256_sub_epi8(counters, compare_avx2(data + i, needle));
+                }
+                __m256i sums = _mm256_sad_epu8(counters, _mm256_setzero_si256());
+                __m128i halves = _mm_add_epi64(
+                    _mm256_castsi256_si128(sums), _mm256_extracti128_si256(sums, 1)
+                );
+                matched_bytes += static_cast<std::size_t>(_mm_cvtsi128_si32(halves));
+                matched_bytes += static_cast<std::size_t>(_mm_cvtsi128_si32(_mm_unpackhi_epi64(halves, halves)));
+            }
+            return matched_bytes / sizeof(T) + count_sse2(data + i, size - i, value);
+        }
+#endif
+
+        // find_scalar() using the given instruction set, which must be supported
+        template <typename T>
+        std::size_t find(simd_level level, const T* data, std::size_t size, const T& value) {
+#ifdef COM_SAXBOPHONE_CODLILI_X86_SIMD
+            if constexpr (is_simd_searchable_v<T>) {
+                switch (level) {
+                case simd_level::AVX2:
+                    return find_avx2(data, size, value);
+                case simd_level::SSE2:
+                    return find_sse2(data, size, value);
+                case simd_level::SCALAR:
+                    break;
+                }
+            }
+#endif
+            return find_scalar(data, size, value);
+        }
+
+        // count_scalar() using the given instruction set, which must be supported
+        template <typename T>
+        std::size_t count(simd_level level, const T* data, std::size_t size, const T& value) {
+#ifdef COM_SAXBOPHONE_CODLILI_X86_SIMD
+            if constexpr (is_simd_searchable_v<T>) {
+                switch (level) {
+                case simd_level::AVX2:
+                    return count_avx2(data, size, value);
+                case simd_level::SSE2:
+                    return count_sse2(data, size, value);
+                case simd_level::SCALAR:
+                    break;
+                }
+            }
+#endif
+            return count_scalar(data, size, value);
+        }
+
+        // find_scalar(), using the fastest instruction set available when not constant-evaluated
+        template <typename T>
+        constexpr std::size_t find(const T* data, std::size_t size, const T& value) {
+            if constexpr (is_simd_searchable_v<T>) {
+                if (not std::is_constant_evaluated()) {
+                    return find(detect_simd_level(), data, size, value);
+                }
+            }
+            return find_scalar(data, size, value);
+        }
+
+        // count_scalar(), using the fastest instruction set available when not constant-evaluated
+        template <typename T>
+        constexpr std::size_t count(const T* data, std::size_t size, const T& value) {
+            if constexpr (is_simd_searchable_v<T>) {
+                if (not std::is_constant_evaluated()) {
+                    return count(detect_simd_level(), data, size, value);
+                }
+            }
+            return count_scalar(data, size, value);
+        }
+
+        // how many bits are set in the size words of data
+        constexpr std::size_t popcount_scalar(const std::uint64_t* data, std::size_t size) {
+            std::size_t bits = 0;
+            for (std::size_t i = 0; i < size; i++) {
+                bits += static_cast<std::size_t>(std::popcount(data[i]));
+            }
+            return bits;
+        }
+
+#ifdef COM_SAXBOPHONE_CODLILI_X86_SIMD
+        // without this, the compiler counts bits with a library call rather than an instruction
+        [[gnu::target("popcnt")]] inline std::size_t popcount_popcnt(const std::uint64_t* data, std::size_t size) {
+            std::size_t bits = 0;
+            for (std::size_t i = 0; i < size; i++) {
+                bits += static_cast<std::size_t>(__builtin_popcountll(data[i]));
+            }
+            return bits;
+        }
+#endif
+
+        // popcount_scalar(), using the POPCNT instruction when available and not constant-evaluated
+        constexpr std::size_t popcount(const std::uint64_t* data, std::size_t size) {
+#ifdef COM_SAXBOPHONE_CODLILI_X86_SIMD
+            // every CPU with AVX2 has POPCNT
+            if (not std::is_constant_evaluated() and detect_simd_level() == simd_level::AVX2) {
+                return popcount_popcnt(data, size);
+            }
+#endif
+            return popcount_scalar(data, size);
+        }
+
+        /*
+         * the first element from first up to last which isn't less than key,
+         * where the elements are sorted by less(element, key). The range is
+         * halved with a conditional move rather than a branch, so the loop
+         * never mispredicts, and always runs log2(last - first) times.
+         */
+        template <std::random_access_iterator It, typename Key, typename Less>
+        constexpr It branchless_lower_bound(It first, It last, const Key& key, Less less) {
+            auto length = last - first;
+            if (length == 0) { return first; }
+            while (length > 1) {
+                auto half = length / 2;
+                first = less(first[half], key) ? first + half : first;
+                length -= half;
+            }
+            return less(*first, key) ? first + 1 : first;
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,676 @@
+/*
+ * Created by Joshua Saxby <joshua.a.saxby@gmail.com>, October 2026
+ * Copyright Joshua Saxby <joshua.a.saxby@gmail.com> 2026
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef COM_SAXBOPHONE_CODLILI_SEGMENTED_SHARRAY_HPP
+#define COM_SAXBOPHONE_CODLILI_SEGMENTED_SHARRAY_HPP
+
+#include <cstddef>          // ptrdiff_t, size_t
+
+#include <algorithm>        // equal, lexicographical_compare_three_way, max, min, move, move_backward, reverse, rotate
+#include <bit>              // bit_ceil, countr_zero, has_single_bit
+#include <compare>          // three_way_comparable
+#include <initializer_list> // initializer_list
+#include <iterator>         // input_iterator, make_move_iterator, random_access_iterator_tag, reverse_iterator
+#include <limits>           // numeric_limits
+#include <memory>           // allocator, allocator_traits
+#include <span>             // span
+#include <stdexcept>        // out_of_range
+#include <type_traits>      // conditional_t
+#include <utility>          // exchange, forward, move, swap
+
+#include <codlili/search.hpp>
+#include <codlili/sharray.hpp>
+
+
+namespace com::saxbophone::codlili {
+    namespace detail {
+        // the default chunk size of segmented_sharray<T>: about 4KiB, in a power of two elements
+        template <typename T>
+        inline constexpr std::size_t default_chunk_size = std::bit_ceil(
+            std::max<std::size_t>(4096 / sizeof(T), 16)
+        );
+
+        /*
+         * iterator of segmented_sharray, which finds elements by splitting
+         * their position into the index of their chunk and the index within it
+         */
+        template <typename T, std::size_t ChunkSize, bool Const>
+        class segmented_iterator {
+        public:
+            using iterator_concept = std::random_access_iterator_tag;
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = std::conditional_t<Const, const T*, T*>;
+            using reference = std::conditional_t<Const, const T&, T&>;
+
+            constexpr segmented_iterator() = default;
+            constexpr segmented_iterator(T* const* chunks, std::size_t position)
+              : _chunks(chunks)
+              , _position(position)
+              {}
+            constexpr segmented_iterator(const segmented_iterator&) = default;
+            constexpr segmented_iterator& operator=(const segmented_iterator&) = default;
+            // iterator converts to const_iterator
+            constexpr segmented_iterator(const segmented_iterator<T, ChunkSize, false>& other)
+            requires Const
+              : _chunks(other._chunks)
+              , _position(other._position)
+              {}
+
+            constexpr reference operator*() const {
+                return _chunks[_position >> _SHIFT][_position & _MASK];
+            }
+            constexpr pointer operator->() const { return &**this; }
+            constexpr reference operator[](difference_type n) const { return *(*this + n); }
+
+            constexpr segmented_iterator& operator++() { _position++; return *this; }
+            constexpr segmented_iterator operator++(int) { auto old = *this; ++*this; return old; }
+            constexpr segmented_iterator& operator--() { _position--; return *this; }
+            constexpr segmented_iterator operator--(int) { auto old = *this; --*this; return old; }
+            // unsigned arithmetic wraps around, so adding a negative offset works too
+            constexpr segmented_iterator& operator+=(difference_type n) {
+                _position += static_cast<std::size_t>(n);
+                return *this;
+            }
+            constexpr segmented_iterator& operator-=(difference_type n) {
+                _position -= static_cast<std::size_t>(n);
+                return *this;
+            }
+            friend constexpr segmented_iterator operator+(segmented_iterator it, difference_type n) {
+                return it += n;
+            }
+            friend constexpr segmented_iterator operator+(difference_type n, segmented_iterator it) {
+                return it += n;
+            }
+            friend constexpr segmented_iterator operator-(segmented_iterator it, difference_type n) {
+                return it -= n;
+            }
+            friend constexpr difference_type operator-(
+                const segmented_iterator& lhs, const segmented_iterator& rhs
+            ) {
+                return static_cast<difference_type>(lhs._position - rhs._position);
+            }
+            friend constexpr bool operator==(
+                const segmented_iterator& lhs, const segmented_iterator& rhs
+            ) {
+                return lhs._position == rhs._position;
+            }
+            friend constexpr auto operator<=>(
+                const segmented_iterator& lhs, const segmented_iterator& rhs
+            ) {
+                return lhs._position <=> rhs._position;
+            }
+        private:
+            template <typename, std::size_t, bool>
+            friend class segmented_iterator;
+
+            static constexpr std::size_t _SHIFT = static_cast<std::size_t>(std::countr_zero(ChunkSize));
+            static constexpr std::size_t _MASK = ChunkSize - 1;
+
+            T* const* _chunks = nullptr;
+            std::size_t _position = 0; // of the element from the start of the first chunk
+        };
+    }
+
+    /**
+     * @brief A sharray of fixed-size chunks of elements, for very large sizes
+     * @details segmented_sharray supports the same operations as sharray,
+     * and grows at either end, but instead of keeping all elements in one
+     * block it keeps them in chunks of ChunkSize elements, with a sharray of
+     * pointers to the chunks. Growing adds a chunk at that end, so elements
+     * are never moved or copied to make room, and only the (ChunkSize times
+     * smaller) array of pointers ever has to be reallocated. This bounds the
+     * worst-case time of a push, and avoids needing twice the memory in use
+     * while growing. Random access is still O(1), as ChunkSize is a power of
+     * two and an element's chunk is found by a shift and a mask.
+     * @note Elements are not contiguous, so there's no data(), and unlike
+     * sharray, references to elements stay valid when pushing at either end.
+     * Iterators are invalidated by any insertion, as with std::deque.
+     * @note As with std::deque, one empty chunk is kept spare at each end, so
+     * that pushing and popping back and forth across the edge of a chunk
+     * doesn't allocate and free it each time. Any others are freed as soon
+     * as they're emptied, so there's no reserve(), and capacity() is simply
+     * the size of all the chunks. shrink_to_fit() frees the spares.
+     * @tparam T the type of elements to store
+     * @tparam ChunkSize how many elements to store in each chunk, which must
+     * be a power of two
+     * @tparam Allocator the allocator to use for chunks and the array of them
+     */
+    template <
+        typename T,
+        std::size_t ChunkSize = detail::default_chunk_size<T>,
+        class Allocator = std::allocator<T>
+    >
+    requires (std::has_single_bit(ChunkSize))
+    class segmented_sharray {
+    private:
+        // allocator for the array of pointers to chunks
+        using ChunkAllocator = std::allocator_traits<Allocator>::template rebind_alloc<T*>;
+        using TAllocator = std::allocator_traits<Allocator>::template rebind_traits<T>;
+    public:
+        using value_type = T;
+        using allocator_type = Allocator;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using reference = T&;
+        using const_reference = const T&;
+        using pointer = typename std::allocator_traits<Allocator>::pointer;
+        using const_pointer = typename std::allocator_traits<Allocator>::const_pointer;
+        using iterator = detail::segmented_iterator<T, ChunkSize, false>;
+        using const_iterator = detail::segmented_iterator<T, ChunkSize, true>;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+        static constexpr size_type chunk_size = ChunkSize;
+        // member functions
+        constexpr segmented_sharray() noexcept(noexcept(Allocator())) {}
+        constexpr explicit segmented_sharray(const Allocator& alloc) noexcept
+          : _allocator(alloc)
+          , _chunks(ChunkAllocator(alloc))
+          {}
+
+        constexpr segmented_sharray(
+            size_type count,
+            const T& value,
+            const Allocator& alloc = Allocator()
+        )
+          : segmented_sharray(alloc) // delegated, so the destructor cleans up if this throws
+          {
+            resize(count, value);
+        }
+
+        constexpr explicit segmented_sharray(
+            size_type count, const Allocator& alloc = Allocator()
+        )
+          : segmented_sharray(alloc)
+          {
+            resize(count);
+        }
+
+        template<std::input_iterator InputIt>
+        constexpr segmented_sharray(
+            InputIt first, InputIt last, const Allocator& alloc = Allocator()
+        )
+          : segmented_sharray(alloc)
+          {
+            _append(first, last);
+        }
+
+        constexpr segmented_sharray(const segmented_sharray& other)
+          : segmented_sharray(
+                other,
+                TAllocator::select_on_container_copy_construction(other._allocator)
+            )
+          {}
+
+        constexpr segmented_sharray(const segmented_sharray& other, const Allocator& alloc)
+          : segmented_sharray(alloc)
+          {
+            _append(other.begin(), other.end());
+        }
+
+        constexpr segmented_sharray(segmented_sharray&& other) noexcept
+          : _allocator(std::move(other._allocator))
+          , _chunks(std::move(other._chunks))
+          , _first(std::exchange(other._first, 0))
+          , _size(std::exchange(other._size, 0))
+          {}
+
+        constexpr segmented_sharray(segmented_sharray&& other, const Allocator& alloc)
+          : segmented_sharray(alloc)
+          {
+            if (_allocator == other._allocator) {
+                _take_chunks(other);
+                return;
+            }
+            // other's chunks can't be freed with our allocator, so its elements are moved individually
+            for (T& element : other) {
+                emplace_back(std::move(element));
+            }
+        }
+
+        constexpr segmented_sharray(
+            std::initializer_list<T> init, const Allocator& alloc = Allocator()
+        )
+          : segmented_sharray(init.begin(), init.end(), alloc)
+          {}
+
+        constexpr ~segmented_sharray() {
+            _free_all();
+        }
+
+        constexpr segmented_sharray& operator=(const segmented_sharray& other) {
+            if (this == &other) { return *this; }
+            if constexpr (TAllocator::propagate_on_container_copy_assignment::value) {
+                if (_allocator != other._allocator) {
+                    // our chunks can't be kept, as the allocator they came from is being replaced
+                    _free_all();
+                    const sharray<T*, ChunkAllocator> no_chunks(ChunkAllocator(other._allocator));
+                    _chunks = no_chunks;
+                }
+                _allocator = other._allocator;
+            }
+            assign(other.begin(), other.end());
+            return *this;
+        }
+        constexpr segmented_sharray& operator=(segmented_sharray&& other) noexcept(
+            TAllocator::propagate_on_container_move_assignment::value or
+            TAllocator::is_always_equal::value
+        ) {
+            if (this == &other) { return *this; }
+            // our own elements and chunks go first, using the allocator they came from
+            _free_all();
+            if constexpr (TAllocator::propagate_on_container_move_assignment::value) {
+                _allocator = other._allocator;
+            } else if (_allocator != other._allocator) {
+                // we can't take ownership of other's chunks, so must move each element individually
+                _append(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+                return *this;
+            }
+            _take_chunks(other);
+            return *this;
+        }
+        constexpr segmented_sharray& operator=(std::initializer_list<T> ilist) {
+            assign(ilist);
+            return *this;
+        }
+        constexpr void assign(size_type count, const T& value) {
+            clear();
+            resize(count, value);
+        }
+        template<std::input_iterator InputIt>
+        constexpr void assign(InputIt first, InputIt last) {
+            clear();
+            _append(first, last);
+        }
+        constexpr void assign(std::initializer_list<T> ilist) {
+            assign(ilist.begin(), ilist.end());
+        }
+        constexpr allocator_type get_allocator() const noexcept { return _allocator; }
+        // element access
+        constexpr reference at(size_type pos) {
+            if (pos >= _size) {
+                throw std::out_of_range("segmented_sharray index out of range");
+            }
+            return (*this)[pos];
+        }
+        constexpr const_reference at(size_type pos) const {
+            if (pos >= _size) {
+                throw std::out_of_range("segmented_sharray index out of range");
+            }
+            return (*this)[pos];
+        }
+        constexpr reference operator[](size_type pos) { return *_slot(_first + pos); }
+        constexpr const_reference operator[](size_type pos) const { return *_slot(_first + pos); }
+        constexpr reference front() { return (*this)[0]; }
+        constexpr const_reference front() const { return (*this)[0]; }
+        constexpr reference back() { return (*this)[_size - 1]; }
+        constexpr const_reference back() const { return (*this)[_size - 1]; }
+        // iterators
+        constexpr iterator begin() noexcept { return {_chunks.data(), _first}; }
+        constexpr const_iterator begin() const noexcept { return {_chunks.data(), _first}; }
+        constexpr const_iterator cbegin() const noexcept { return begin(); }
+        constexpr iterator end() noexcept { return {_chunks.data(), _first + _size}; }
+        constexpr const_iterator end() const noexcept { return {_chunks.data(), _first + _size}; }
+        constexpr const_iterator cend() const noexcept { return end(); }
+        constexpr reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+        constexpr const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+        constexpr const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+        constexpr reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+        constexpr const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+        constexpr const_reverse_iterator crend() const noexcept { return rend(); }
+        // capacity
+        [[nodiscard]] constexpr bool empty() const noexcept { return _size == 0; }
+        constexpr size_type size() const noexcept { return _size; }
+        constexpr size_type max_size() const noexcept {
+            return std::numeric_limits<difference_type>::max();
+        }
+        constexpr size_type capacity() const noexcept { return _chunks.size() * ChunkSize; }
+        // frees the spare chunks at either end, and spare space in the array of pointers to them
+        constexpr void shrink_to_fit() {
+            if (_size == 0) {
+                _free_all();
+            }
+            while (_first >= ChunkSize) {
+                _free_chunk_front();
+            }
+            while (_first + _size + ChunkSize <= capacity()) {
+                _free_chunk_back();
+            }
+            _chunks.shrink_to_fit();
+        }
+        // modifiers
+        constexpr void clear() noexcept {
+            for (size_type i = 0; i < _size; i++) {
+                TAllocator::destroy(_allocator, _slot(_first + i));
+            }
+            _size = 0;
+            // one chunk is kept, with room to push into at either end
+            while (_chunks.size() > 1) {
+                _free_chunk_back();
+            }
+            _first = _chunks.empty() ? 0 : ChunkSize / 2;
+        }
+        constexpr iterator insert(const_iterator pos, const T& value) {
+            return emplace(pos, value);
+        }
+        constexpr iterator insert(const_iterator pos, T&& value) {
+            return emplace(pos, std::move(value));
+        }
+        constexpr iterator insert(
+            const_iterator pos, size_type count, const T& value
+        ) {
+            size_type index = _index_of(pos);
+            // pushing never moves elements, so value stays valid even if it's one of ours
+            if (index < _size - index) {
+                size_type old_size = _size;
+                _undo_on_throw(old_size, true, [&] {
+                    for (size_type i = 0; i < count; i++) {
+                        emplace_front(value);
+                    }
+                });
+                std::rotate(begin(), begin() + _offset(count), begin() + _offset(count + index));
+            } else {
+                size_type old_size = _size;
+                _undo_on_throw(old_size, false, [&] {
+                    for (size_type i = 0; i < count; i++) {
+                        emplace_back(value);
+                    }
+                });
+                std::rotate(begin() + _offset(index), begin() + _offset(old_size), end());
+            }
+            return begin() + _offset(index);
+        }
+        template<std::input_iterator InputIt>
+        constexpr iterator insert(
+            const_iterator pos, InputIt first, InputIt last
+        ) {
+            size_type index = _index_of(pos);
+            size_type old_size = _size;
+            // the new elements are pushed at whichever end is nearest, then rotated into place
+            if (index < _size - index) {
+                _undo_on_throw(old_size, true, [&] {
+                    for (; first != last; ++first) {
+                        emplace_front(*first);
+                    }
+                });
+                size_type count = _size - old_size;
+                std::reverse(begin(), begin() + _offset(count));
+                std::rotate(begin(), begin() + _offset(count), begin() + _offset(count + index));
+            } else {
+                _undo_on_throw(old_size, false, [&] { _append(first, last); });
+                std::rotate(begin() + _offset(index), begin() + _offset(old_size), end());
+            }
+            return begin() + _offset(index);
+        }
+        constexpr iterator insert(
+            const_iterator pos, std::initializer_list<T> ilist
+        ) {
+            return insert(pos, ilist.begin(), ilist.end());
+        }
+        template<class... Args>
+        constexpr iterator emplace(const_iterator pos, Args&&... args) {
+            size_type index = _index_of(pos);
+            if (index < _size - index) {
+                emplace_front(std::forward<Args>(args)...);
+                std::rotate(begin(), begin() + 1, begin() + _offset(index + 1));
+            } else {
+                emplace_back(std::forward<Args>(args)...);
+                std::rotate(begin() + _offset(index), end() - 1, end());
+            }
+            return begin() + _offset(index);
+        }
+        constexpr iterator erase(const_iterator pos) {
+            return erase(pos, pos + 1);
+        }
+        constexpr iterator erase(const_iterator first, const_iterator last) {
+            size_type index = _index_of(first);
+            size_type count = static_cast<size_type>(last - first);
+            if (count == 0) { return begin() + _offset(index); }
+            // close the gap by moving whichever side of it has fewer elements
+            if (index < _size - index - count) {
+                std::move_backward(begin(), begin() + _offset(index), begin() + _offset(index + count));
+                for (size_type i = 0; i < count; i++) {
+                    pop_front();
+                }
+            } else {
+                std::move(begin() + _offset(index + count), end(), begin() + _offset(index));
+                for (size_type i = 0; i < count; i++) {
+                    pop_back();
+                }
+            }
+            return begin() + _offset(index);
+        }
+        constexpr void push_back(const T& value) {
+            emplace_back(value);
+        }
+        constexpr void push_back(T&& value) {
+            emplace_back(std::move(value));
+        }
+        template<class... Args>
+        constexpr reference emplace_back(Args&&... args) {
+            bool added = false;
+            if (_first + _size == capacity()) {
+                _add_chunk_back();
+                added = true;
+            }
+            T* element = _slot(_first + _size);
+            try {
+                TAllocator::construct(_allocator, element, std::forward<Args>(args)...);
+            } catch (...) {
+                if (added) { _free_chunk_back(); }
+                throw;
+            }
+            _size++;
+            return *element;
+        }
+        constexpr void pop_back() {
+            _size--;
+            TAllocator::destroy(_allocator, _slot(_first + _size));
+            _free_empty_chunks();
+        }
+        constexpr void push_front(const T& value) {
+            emplace_front(value);
+        }
+        constexpr void push_front(T&& value) {
+            emplace_front(std::move(value));
+        }
+        template<class... Args>
+        constexpr reference emplace_front(Args&&... args) {
+            bool added = false;
+            if (_first == 0) {
+                _add_chunk_front();
+                added = true;
+            }
+            T* element = _slot(_first - 1);
+            try {
+                TAllocator::construct(_allocator, element, std::forward<Args>(args)...);
+            } catch (...) {
+                if (added) { _free_chunk_front(); }
+                throw;
+            }
+            _first--;
+            _size++;
+            return *element;
+        }
+        constexpr void pop_front() {
+            TAllocator::destroy(_allocator, _slot(_first));
+            _first++;
+            _size--;
+            _free_empty_chunks();
+        }
+        constexpr void resize(size_type count) {
+            while (_size > count) {
+                pop_back();
+            }
+            while (_size < count) {
+                emplace_back();
+            }
+        }
+        constexpr void resize(size_type count, const value_type& value) {
+            while (_size > count) {
+                pop_back();
+            }
+            // pushing never moves elements, so value stays valid even if it's one of ours
+            while (_size < count) {
+                emplace_back(value);
+            }
+        }
+        constexpr void swap(segmented_sharray& other) noexcept {
+            if constexpr (TAllocator::propagate_on_container_swap::value) {
+                std::swap(_allocator, other._allocator);
+            }
+            _chunks.swap(other._chunks);
+            std::swap(_first, other._first);
+            std::swap(_size, other._size);
+        }
+        // lookup
+        // iterator to the first element equal to value, or end() if there isn't one
+        constexpr iterator find(const T& value) {
+            return begin() + _offset(_find(value));
+        }
+        constexpr const_iterator find(const T& value) const {
+            return begin() + _offset(_find(value));
+        }
+        constexpr size_type count(const T& value) const {
+            size_type total = 0;
+            for (size_type index = 0; index < _size; ) {
+                std::span<const T> run = _run(index);
+                total += detail::count(run.data(), run.size(), value);
+                index += run.size();
+            }
+            return total;
+        }
+        constexpr bool contains(const T& value) const {
+            return _find(value) != _size;
+        }
+        // comparison
+        constexpr bool operator==(const segmented_sharray& other) const {
+            return _size == other._size and std::equal(begin(), end(), other.begin());
+        }
+        constexpr auto operator<=>(const segmented_sharray& other) const
+        requires std::three_way_comparable<T> {
+            return std::lexicographical_compare_three_way(
+                begin(), end(), other.begin(), other.end()
+            );
+        }
+    private:
+        static constexpr size_type _SHIFT = static_cast<size_type>(std::countr_zero(ChunkSize));
+        static constexpr size_type _MASK = ChunkSize - 1;
+
+        // the storage for the element at position from the start of the first chunk
+        constexpr T* _slot(size_type position) const {
+            return _chunks[position >> _SHIFT] + (position & _MASK);
+        }
+        // the elements from index up to the end of its chunk or the last element, whichever is first
+        constexpr std::span<const T> _run(size_type index) const {
+            size_type position = _first + index;
+            return {_slot(position), std::min(ChunkSize - (position & _MASK), _size - index)};
+        }
+        // index of the first element equal to value, or _size if there isn't one
+        constexpr size_type _find(const T& value) const {
+            for (size_type index = 0; index < _size; ) {
+                std::span<const T> run = _run(index);
+                size_type found = detail::find(run.data(), run.size(), value);
+                if (found != run.size()) { return index + found; }
+                index += run.size();
+            }
+            return _size;
+        }
+        constexpr size_type _index_of(const_iterator pos) const {
+            return static_cast<size_type>(pos - cbegin());
+        }
+        static constexpr difference_type _offset(size_type index) {
+            return static_cast<difference_type>(index);
+        }
+        constexpr void _add_chunk_back() {
+            T* chunk = TAllocator::allocate(_allocator, ChunkSize);
+            try {
+                _chunks.push_back(chunk);
+            } catch (...) {
+                TAllocator::deallocate(_allocator, chunk, ChunkSize);
+                throw;
+            }
+        }
+        constexpr void _add_chunk_front() {
+            T* chunk = TAllocator::allocate(_allocator, ChunkSize);
+            try {
+                _chunks.push_front(chunk);
+            } catch (...) {
+                TAllocator::deallocate(_allocator, chunk, ChunkSize);
+                throw;
+            }
+            _first += ChunkSize;
+        }
+        constexpr void _free_chunk_back() {
+            TAllocator::deallocate(_allocator, _chunks.back(), ChunkSize);
+            _chunks.pop_back();
+        }
+        constexpr void _free_chunk_front() {
+            TAllocator::deallocate(_allocator, _chunks.front(), ChunkSize);
+            _chunks.pop_front();
+            _first -= ChunkSize;
+        }
+        // frees the chunk at either end if it and the one next to it have no elements left in them
+        constexpr void _free_empty_chunks() {
+            if (_first >= 2 * ChunkSize) {
+                _free_chunk_front();
+            }
+            if (_first + _size + 2 * ChunkSize <= capacity()) {
+                _free_chunk_back();
+            }
+        }
+        // destroys all elements and frees all chunks
+        constexpr void _free_all() noexcept {
+            clear();
+            if (not _chunks.empty()) {
+                _free_chunk_back();
+            }
+            _first = 0;
+        }
+        /*
+         * calls push, which pushes elements at the front or back, and if it
+         * throws, pops any that it pushed before rethrowing, leaving old_size
+         */
+        template <typename Push>
+        constexpr void _undo_on_throw(size_type old_size, bool at_front, Push push) {
+            try {
+                push();
+            } catch (...) {
+                while (_size > old_size) {
+                    if (at_front) {
+                        pop_front();
+                    } else {
+                        pop_back();
+                    }
+                }
+                throw;
+            }
+        }
+        template <std::input_iterator InputIt>
+        constexpr void _append(InputIt first, InputIt last) {
+            for (; first != last; ++first) {
+                emplace_back(*first);
+            }
+        }
+        // takes over other's chunks, leaving it empty. This must have no elements or chunks
+        constexpr void _take_chunks(segmented_sharray& other) {
+            _chunks = std::move(other._chunks);
+            _first = std::exchange(other._first, 0);
+            _size = std::exchange(other._size, 0);
+        }
+
+        allocator_type _allocator = Allocator();
+        sharray<T*, ChunkAllocator> _chunks{ChunkAllocator(_allocator)}; // pointers to each chunk in order
+        size_type _first = 0; // position of the first element within the first chunk
+        size_type _size = 0;
+    };
+}
+
+#endif
@@ -10,25 +10,64 @@
 #ifndef COM_SAXBOPHONE_CODLILI_SHARRAY_HPP
 #define COM_SAXBOPHONE_CODLILI_SHARRAY_HPP
 
-#include <cstddef>          // size_t
+#include <cstddef>          // byte, size_t
+#include <cstring>          // memcmp, memcpy
 
+#include <algorithm>        // lexicographical_compare_three_way, max, min, move, move_backward
+#include <compare>          // three_way_comparable
 #include <initializer_list> // initializer_list
+#include <iterator>         // contiguous_iterator, distance, forward_iterator, input_iterator, make_move_iterator, reverse_iterator, sentinel_for
 #include <limits>           // numeric_limits
-#include <memory>           // allocator, allocator_traits
+#include <memory>           // allocator, allocator_traits, to_address
+#include <memory_resource>  // polymorphic_allocator
+#include <new>              // placement new
+#include <numeric>          // lcm
+#include <ranges>           // begin, distance, end, input_range
 #include <span>             // span
-#include <stdexcept>        // logic_error
-#include <utility>          // pair
+#include <stdexcept>        // invalid_argument, logic_error
+#include <type_traits>      // is_constant_evaluated, is_same_v, is_trivially_copyable_v, is_trivially_default_constructible_v
+#include <utility>          // forward, move, pair
+
+#include <codlili/growth_policy.hpp>
+#include <codlili/relocate.hpp>
+#include <codlili/search.hpp>
 
 
 namespace com::saxbophone::codlili {
+    namespace detail {
+        struct sharray_file_access;
+
+        // uninitialised space for Capacity objects of T, embedded in whatever owns it
+        template <typename T, std::size_t Capacity>
+        struct inline_buffer {
+            T* data() noexcept { return reinterpret_cast<T*>(bytes); }
+            const T* data() const noexcept { return reinterpret_cast<const T*>(bytes); }
+
+            alignas(T) std::byte bytes[Capacity * sizeof(T)];
+        };
+
+        template <typename T>
+        struct inline_buffer<T, 0> {};
+    }
+
     /**
      * @brief A contiguous container type with both vector<> and deque<> semantics
      * @details sharray supports insertion at both the front and end, like
      * `std::deque<>`.
      * Like `std::vector<>`, sharray also stores its elements contiguously.
      * @tparam T the type of elements to store
+     * @tparam Allocator the allocator to use for storage
+     * @tparam GrowthPolicy decides how much storage to allocate when full
+     * (see `growth_policy`)
+     * @tparam InlineCapacity how many elements can be stored within the object
+     * itself before storage has to be allocated (see `small_sharray`)
      */
-    template <typename T, class Allocator = std::allocator<T>>
+    template <
+        typename T,
+        class Allocator = std::allocator<T>,
+        growth_policy GrowthPolicy = default_growth,
+        std::size_t InlineCapacity = 0
+    >
     class sharray {
     public:
         using value_type = T;
@@ -39,10 +78,18 @@ namespace com::saxbophone::codlili {
         using const_reference = const T&;
         using pointer = typename std::allocator_traits<Allocator>::pointer;
         using const_pointer = typename std::allocator_traits<Allocator>::const_pointer;
-        using iterator = std::span<T>::iterator;
-        using const_iterator = std::span<const T>::iterator;
-        using reverse_iterator = std::span<T>::reverse_iterator;
-        using const_reverse_iterator = std::span<const T>::reverse_iterator;
+        // plain pointers, as (unlike span's iterators) iterator converts to const_iterator
+        using iterator = T*;
+        using const_iterator = const T*;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+        // a block of storage handed over by release(), holding size elements from index base
+        struct buffer {
+            T* data = nullptr;
+            size_type capacity = 0;
+            size_type base = 0;
+            size_type size = 0;
+        };
         // member functions
         constexpr sharray() noexcept(noexcept(Allocator())) {}
         constexpr explicit sharray(const Allocator& alloc) noexcept
@@ -53,13 +100,13 @@ namespace com::saxbophone::codlili {
             const T& value,
             const Allocator& alloc = Allocator()
         )
-          : _allocator(alloc)
-          , _storage{count != 0 ? TAllocator::allocate(_allocator, count) : nullptr, count}
-          , _size(count)
+          : sharray(alloc) // delegated, so the destructor cleans up if this throws
           {
-            for (size_type i = 0; i < _size; i++) {
-                TAllocator::construct(_allocator, _storage.data + i, value);
-            }
+            _allocate_centred(count);
+            _construct_each(_storage.data + _base_index, count, [&](T* element) {
+                TAllocator::construct(_allocator, element, value);
+            });
+            _size = count;
         }
 
         constexpr explicit sharray(
@@ -67,124 +114,150 @@ namespace com::saxbophone::codlili {
         )
           : sharray(count, T(), alloc) {} // default-inserted elements of T
 
-        template<class InputIt>
+        template<std::input_iterator InputIt>
         constexpr sharray(
             InputIt first, InputIt last, const Allocator& alloc = Allocator()
         )
-          : _allocator(alloc) {
-            for (; first != last; first++) {
-                push_back(*first);
+          : sharray(alloc)
+          {
+            if constexpr (std::forward_iterator<InputIt>) {
+                // allocate exactly the space needed up front
+                size_type count = static_cast<size_type>(std::distance(first, last));
+                _allocate_centred(count);
+                _construct_from(_storage.data + _base_index, first, count);
+                _size = count;
+            } else {
+                for (; first != last; ++first) {
+                    emplace_back(*first);
+                }
             }
         }
 
         constexpr sharray(const sharray& other)
-          : _allocator(
-                std::allocator_traits<Allocator>::select_on_container_copy_construction(
-                    other.get_allocator()
-                )
+          : sharray(
+                other,
+                TAllocator::select_on_container_copy_construction(other._allocator)
             )
-          , _storage{other.size() != 0 ? TAllocator::allocate(_allocator, other.size()) : nullptr, other.size()}
-          , _size(other.size())
-          {
-            for (std::size_t i = 0; i < _size; i++) {
-                TAllocator::construct(_allocator, _storage.data + i, other[i]);
-            }
-        }
+          {}
 
         constexpr sharray(const sharray& other, const Allocator& alloc)
-          : _allocator(alloc) {
-            throw std::logic_error("Not implemented");
+          : sharray(alloc)
+          {
+            _allocate_centred(other.size());
+            _construct_from(_storage.data + _base_index, other.begin(), other.size());
+            _size = other.size();
         }
 
-        constexpr sharray(sharray&& other) noexcept
+        constexpr sharray(sharray&& other) noexcept(_nothrow_take_elements())
           : _allocator(std::move(other._allocator))
-          , _storage(std::move(other._storage))
-          , _base_index(other._base_index)
-          , _size(other._size)
+          , _front_pushes(other._front_pushes)
+          , _back_pushes(other._back_pushes)
           {
-            other._storage = {};
-            other._base_index = 0;
-            other._size = 0;
+            _take_elements(other);
         }
 
         constexpr sharray(sharray&& other, const Allocator& alloc)
-          : _allocator(alloc) {
-            throw std::logic_error("Not implemented");
+          : sharray(alloc)
+          {
+            if (_allocator == other._allocator) {
+                _take_elements(other);
+                return;
+            }
+            // other's storage can't be freed with our allocator, so its elements are moved individually
+            _allocate_centred(other.size());
+            _construct_each(_storage.data + _base_index, other.size(), [&, i = size_type(0)](T* element) mutable {
+                TAllocator::construct(_allocator, element, std::move(other[i++]));
+            });
+            _size = other.size();
+            other._release_storage();
         }
 
         constexpr sharray(
             std::initializer_list<T> init, const Allocator& alloc = Allocator()
         )
-          : _allocator(alloc)
-          , _storage{init.size() != 0 ? TAllocator::allocate(_allocator, init.size()) : nullptr, init.size()}
-          , _size(init.size())
+          : sharray(alloc)
           {
-            auto it = init.begin();
-            for (size_type i = 0; i < _size; i++) {
-                TAllocator::construct(_allocator, _storage.data + i, *it);
-                it++;
-            }
+            _allocate_centred(init.size());
+            _construct_from(_storage.data + _base_index, init.begin(), init.size());
+            _size = init.size();
         }
 
         constexpr ~sharray() {
-            if (_storage.data == nullptr) { return; }
-            // destroy any constructed objects first
-            for (size_type i = _base_index; i < _base_index + _size; i++) {
-                TAllocator::destroy(_allocator, _storage.data + i);
-            }
-            // then deallocate all memory
-            TAllocator::deallocate(_allocator, _storage.data, _storage.size);
+            _release_storage();
         }
 
         constexpr sharray& operator=(const sharray& other) {
-            throw std::logic_error("Not implemented");
+            if (this == &other) { return *this; }
+            if constexpr (TAllocator::propagate_on_container_copy_assignment::value) {
+                if (_allocator != other._allocator) {
+                    // our storage can't be kept, as the allocator it came from is being replaced
+                    sharray copy(other, other._allocator);
+                    _release_storage();
+                    _allocator = other._allocator;
+                    _take_elements(copy);
+                    return *this;
+                }
+                _allocator = other._allocator;
+            }
+            _assign(other.size(), [&](T* destination) {
+                _construct_from(destination, other.begin(), other.size());
+            });
+            return *this;
         }
-        constexpr sharray& operator=(sharray&& other) noexcept {
-            // TODO: implement proper handling of allocator according to deque:
-            /*
-             * If std::allocator_traits<allocator_type>::propagate_on_container_move_assignment::value
-             * is true, the allocator of *this is replaced by a copy of that of
-             * other. If it is false and the allocators of *this and other do
-             * not compare equal, *this cannot take ownership of the memory
-             * owned by other and must move-assign each element individually,
-             * allocating additional memory using its own allocator as needed.
-             * In any case, all elements originally belong to *this are either
-             * destroyed or replaced by element-wise move-assignment.
-             */
+        constexpr sharray& operator=(sharray&& other) noexcept(_nothrow_move_assign()) {
+            if (this == &other) { return *this; }
+            if constexpr (not TAllocator::propagate_on_container_move_assignment::value) {
+                if (_allocator != other._allocator) {
+                    /*
+                     * *this cannot take ownership of the memory owned by other,
+                     * so must move each element individually into its own storage
+                     */
+                    sharray moved(std::move(other), _allocator);
+                    _release_storage();
+                    _take_elements(moved);
+                    return *this;
+                }
+            }
+            // our own elements and storage go first, using the allocator they came from
+            _release_storage();
             if constexpr (TAllocator::propagate_on_container_move_assignment::value) {
                 // the allocator of *this is replaced by a copy of that of other
                 _allocator = other._allocator;
             }
-            if (_allocator != other._allocator) {
-                /*
-                 * If the allocators of *this and other do not compare equal,
-                 * *this cannot take ownership of the memory owned by other and
-                 * must move-assign each element individually
-                 */
-                // TODO: implement assignment in this case
-            } else {
-                // otherwise, we move-assign the elements of other
-                _storage = std::move(other._storage);
-                other._storage = {};
-            }
-            _base_index = other._base_index;
-            other._base_index = 0;
-            _size = other._size;
-            other._size = 0;
+            _take_elements(other);
+            _front_pushes = other._front_pushes;
+            _back_pushes = other._back_pushes;
             return *this;
         }
         constexpr sharray& operator=(std::initializer_list<T> ilist) {
-            throw std::logic_error("Not implemented");
+            assign(ilist);
+            return *this;
         }
         constexpr void assign(size_type count, const T& value) {
-            throw std::logic_error("Not implemented");
+            // value may refer to one of our elements, which are about to be destroyed
+            const value_type copy = value;
+            _assign(count, [&](T* destination) {
+                _construct_each(destination, count, [&](T* element) {
+                    TAllocator::construct(_allocator, element, copy);
+                });
+            });
         }
-        template<class InputIt>
+        template<std::input_iterator InputIt>
         constexpr void assign(InputIt first, InputIt last) {
-            throw std::logic_error("Not implemented");
+            if constexpr (std::forward_iterator<InputIt>) {
+                size_type count = static_cast<size_type>(std::distance(first, last));
+                _assign(count, [&](T* destination) {
+                    _construct_from(destination, first, count);
+                });
+            } else {
+                resize(0);
+                for (; first != last; ++first) {
+                    emplace_back(*first);
+                }
+            }
         }
         constexpr void assign(std::initializer_list<T> ilist) {
-            throw std::logic_error("Not implemented");
+            assign(ilist.begin(), ilist.end());
         }
         constexpr allocator_type get_allocator() const noexcept { return _allocator; }
         // element access
@@ -204,20 +277,21 @@ namespace com::saxbophone::codlili {
         constexpr const_reference front() const { return _elements().front(); }
         constexpr reference back() { return _elements().back(); }
         constexpr const_reference back() const { return _elements().back(); }
+        constexpr T* data() noexcept { return _elements().data(); }
         constexpr const T* data() const noexcept { return _elements().data(); }
         // iterators
-        constexpr iterator begin() noexcept { return _elements().begin(); }
-        constexpr const_iterator begin() const noexcept { return _elements().begin(); }
-        constexpr const_iterator cbegin() const noexcept { return _elements().begin(); }
-        constexpr iterator end() noexcept { return _elements().end(); }
-        constexpr const_iterator end() const noexcept { return _elements().end(); }
-        constexpr const_iterator cend() const noexcept { return _elements().end(); }
-        constexpr reverse_iterator rbegin() noexcept { return _elements().rbegin(); }
-        constexpr const_reverse_iterator rbegin() const noexcept { return _elements().rbegin(); }
-        constexpr const_reverse_iterator crbegin() const noexcept { return _elements().rbegin(); }
-        constexpr reverse_iterator rend() noexcept { return _elements().rend(); }
-        constexpr const_reverse_iterator rend() const noexcept { return _elements().rend(); }
-        constexpr const_reverse_iterator crend() const noexcept { return _elements().rend(); }
+        constexpr iterator begin() noexcept { return _elements().data(); }
+        constexpr const_iterator begin() const noexcept { return _elements().data(); }
+        constexpr const_iterator cbegin() const noexcept { return begin(); }
+        constexpr iterator end() noexcept { return begin() + _size; }
+        constexpr const_iterator end() const noexcept { return begin() + _size; }
+        constexpr const_iterator cend() const noexcept { return end(); }
+        constexpr reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+        constexpr const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+        constexpr const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+        constexpr reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+        constexpr const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+        constexpr const_reverse_iterator crend() const noexcept { return rend(); }
         // capacity
         [[nodiscard]] constexpr bool empty() const noexcept {
             return _elements().empty();
@@ -227,128 +301,174 @@ namespace com::saxbophone::codlili {
             return std::numeric_limits<difference_type>::max();
         }
         constexpr void reserve(size_type new_cap) {
-            if (new_cap < _storage.size) { return; } // no-op
-            // allocate new storage to the requested size
-            decltype(_storage) new_storage = {
-                TAllocator::allocate(_allocator, new_cap),
-                new_cap
-            };
-            // detemine where the elements start
-            size_type base = (new_cap - _size) / 2;
-            // copy in existing elements
-            for (size_type i = 0; i < _size; i++) {
-                TAllocator::construct(
-                    _allocator,
-                    new_storage.data + base + i,
-                    _elements()[i] // TODO: move from instead?
-                );
-                // destroy old object
-                TAllocator::destroy(_allocator, _storage.data + i);
-            }
-            // swap new storage with old
-            std::swap(new_storage, _storage);
-            // deallocate old storage if non-empty
-            if (new_storage.data != nullptr) {
-                TAllocator::deallocate(_allocator, new_storage.data, new_storage.size);
-            }
+            if (new_cap <= _storage.size) { return; } // no-op
+            // split the spare space according to which end is growing most
+            _reallocate(new_cap, _headroom_front(new_cap - _size));
         }
         // pair of sizes for cap denotes elements to reserve before and after front
         constexpr void reserve(std::pair<size_type, size_type> bidir_cap) {
-            throw std::logic_error("Not implemented"); // XXX: stub
+            auto [behind, ahead] = bidir_cap;
+            // the elements themselves always occupy space after the front
+            ahead = std::max(ahead, _size);
+            if (behind <= _capacity_behind() and ahead <= _capacity_ahead()) {
+                return; // no-op
+            }
+            // if there's enough space in total, the elements can be slid across instead
+            if (_can_slide() and behind + ahead <= _storage.size) {
+                return _slide(behind);
+            }
+            // never take away capacity from either side
+            behind = std::max(behind, _capacity_behind());
+            ahead = std::max(ahead, _capacity_ahead());
+            _reallocate(behind + ahead, behind);
         }
         constexpr size_type capacity() const noexcept { return _storage.size; }
-        constexpr void shrink_to_fit() { /* No implementation required */ }
+        constexpr void shrink_to_fit() {
+            shrink_to_fit({0, 0});
+        }
+        /*
+         * reduces capacity to fit the elements plus headroom.first spare
+         * elements before the front and headroom.second after the back.
+         * Capacity is never increased, and storage within the sharray itself
+         * (see small_sharray) can't be shrunk.
+         */
+        constexpr void shrink_to_fit(std::pair<size_type, size_type> headroom) {
+            auto [behind, ahead] = headroom;
+            size_type new_cap = _size + behind + ahead;
+            if (new_cap >= _storage.size or _is_inline()) { return; }
+            _shrink(new_cap, behind);
+        }
         // modifiers
-        constexpr void clear() noexcept {}
+        constexpr void clear() noexcept {
+            detail::destroy(_allocator, _storage.data + _base_index, _size);
+            _size = 0;
+            _base_index = _storage.size / 2;
+            _shrink_if_sparse();
+        }
         constexpr iterator insert(const_iterator pos, const T& value) {
-            throw std::logic_error("Not implemented"); // XXX: stub
+            return emplace(pos, value);
         }
         constexpr iterator insert(const_iterator pos, T&& value) {
-            throw std::logic_error("Not implemented"); // XXX: stub
+            return emplace(pos, std::move(value));
         }
         constexpr iterator insert(
             const_iterator pos, size_type count, const T& value
         ) {
-            throw std::logic_error("Not implemented"); // XXX: stub
+            size_type index = _index_of(pos);
+            if (count != 0) {
+                // value may refer to one of our elements, which opening the gap could move
+                const value_type copy = value;
+                _insert_gap(index, count, [&](T* gap) {
+                    _construct_each(gap, count, [&](T* element) {
+                        TAllocator::construct(_allocator, element, copy);
+                    });
+                });
+            }
+            return _iterator_at(index);
         }
-        template<class InputIt>
+        template<std::input_iterator InputIt>
         constexpr iterator insert(
             const_iterator pos, InputIt first, InputIt last
         ) {
-            throw std::logic_error("Not implemented"); // XXX: stub
+            size_type index = _index_of(pos);
+            _insert_range(index, first, last);
+            return _iterator_at(index);
         }
         constexpr iterator insert(
             const_iterator pos, std::initializer_list<T> ilist
         ) {
-            throw std::logic_error("Not implemented"); // XXX: stub
+            return insert(pos, ilist.begin(), ilist.end());
         }
         template<class... Args>
         constexpr iterator emplace(const_iterator pos, Args&&... args) {
-            throw std::logic_error("Not implemented"); // XXX: stub
+            size_type index = _index_of(pos);
+            _emplace_at(index, std::forward<Args>(args)...);
+            return _iterator_at(index);
         }
         constexpr iterator erase(const_iterator pos) {
-            throw std::logic_error("Not implemented");
+            return erase(pos, pos + 1);
         }
         constexpr iterator erase(const_iterator first, const_iterator last) {
-            throw std::logic_error("Not implemented");
+            size_type index = _index_of(first);
+            size_type count = static_cast<size_type>(last - first);
+            if (count == 0) { return _iterator_at(index); }
+            T* gap = _storage.data + _base_index + index;
+            size_type after = _size - index - count;
+            // close the gap by moving whichever side of it has fewer elements
+            if constexpr (_can_slide()) {
+                detail::destroy(_allocator, gap, count);
+                _size -= count;
+                _shift_parts(
+                    index, count, 0, index < after ? _base_index + count : _base_index
+                );
+            } else {
+                // moving might throw, so move-assign elements over the gap instead
+                if (index < after) {
+                    std::move_backward(gap - index, gap, gap + count);
+                    detail::destroy(_allocator, gap - index, count);
+                    _base_index += count;
+                } else {
+                    std::move(gap + count, gap + count + after, gap);
+                    detail::destroy(_allocator, gap + after, count);
+                }
+                _size -= count;
+            }
+            _shrink_if_sparse();
+            return _iterator_at(index);
         }
         constexpr void push_back(const T& value) {
-            // make sure there's enough space in back for 1 additional element
-            _grow_back(1);
-            TAllocator::construct(
-                _allocator,
-                _storage.data + _base_index + _size,
-                value
-            );
-            _size++;
+            emplace_back(value);
         }
         constexpr void push_back(T&& value) {
-            // make sure there's enough space in back for 1 additional element
-            _grow_back(1);
-            TAllocator::construct(
-                _allocator,
-                _storage.data + _base_index + _size,
-                value
-            );
-            _size++;
+            emplace_back(std::move(value));
         }
         template<class... Args>
         constexpr reference emplace_back(Args&&... args) {
-            throw std::logic_error("Not implemented");
+            _back_pushes++;
+            if (_size < _capacity_ahead()) {
+                // there's space in back for 1 additional element
+                TAllocator::construct(
+                    _allocator,
+                    _storage.data + _base_index + _size,
+                    std::forward<Args>(args)...
+                );
+                _size++;
+            } else {
+                _emplace_at(_size, std::forward<Args>(args)...);
+            }
+            return back();
         }
         constexpr void pop_back() {
             TAllocator::destroy(_allocator, _storage.data + _base_index + _size - 1);
             _size--;
             // _base_index is reset to halfway if now empty
-            if (_size != 0) {
+            if (_size == 0) {
                 _base_index = _storage.size / 2;
             }
+            _shrink_if_sparse();
         }
         constexpr void push_front(const T& value) {
-            // make sure there's enough space in back for 1 additional element
-            _grow_front(1);
-            TAllocator::construct(
-                _allocator,
-                _storage.data + _base_index - 1,
-                value
-            );
-            _size++;
-            _base_index--;
+            emplace_front(value);
         }
         constexpr void push_front(T&& value) {
-            // make sure there's enough space in back for 1 additional element
-            _grow_front(1);
-            TAllocator::construct(
-                _allocator,
-                _storage.data + _base_index - 1,
-                value
-            );
-            _size++;
-            _base_index--;
+            emplace_front(std::move(value));
         }
         template<class... Args>
         constexpr reference emplace_front(Args&&... args) {
-            throw std::logic_error("Not implemented");
+            _front_pushes++;
+            if (_capacity_behind() != 0) {
+                // there's space in front for 1 additional element
+                TAllocator::construct(
+                    _allocator,
+                    _storage.data + _base_index - 1,
+                    std::forward<Args>(args)...
+                );
+                _size++;
+                _base_index--;
+            } else {
+                _emplace_at(0, std::forward<Args>(args)...);
+            }
+            return front();
         }
         constexpr void pop_front() {
             TAllocator::destroy(_allocator, _storage.data + _base_index);
@@ -359,46 +479,264 @@ namespace com::saxbophone::codlili {
             } else {
                 _base_index = _storage.size / 2;
             }
+            _shrink_if_sparse();
+        }
+        // inserts all the elements of range after the last element
+        template <std::ranges::input_range R>
+        constexpr void append_range(R&& range) {
+            _insert_range(_size, std::ranges::begin(range), std::ranges::end(range));
+        }
+        // inserts all the elements of range before the first element, keeping their order
+        template <std::ranges::input_range R>
+        constexpr void prepend_range(R&& range) {
+            _insert_range(0, std::ranges::begin(range), std::ranges::end(range));
         }
         constexpr void resize(size_type count) {
-            while (count < _size) {
-                pop_back();
-            }
-            while (count > _size) {
-                push_back(T());
-            }
+            resize({0, count});
         }
         constexpr void resize(size_type count, const value_type& value) {
-            throw std::logic_error("Not implemented");
+            resize({0, count}, value);
         }
         // pair of counts is defined as number to have before the front of the array and the number to have after it
         constexpr void resize(std::pair<size_type, size_type> count) {
-            throw std::logic_error("Not implemented");
+            // default-inserted elements of T
+            _resize(count, [&](T* element) { TAllocator::construct(_allocator, element); });
         }
+        /*
+         * the "front of the array" is the element which is currently at the
+         * front: count.second is the number of elements to keep from it onwards
+         * (removing or appending copies of value at the back as needed) and
+         * count.first is the number of copies of value to prepend before it.
+         */
         constexpr void resize(
             std::pair<size_type, size_type> count, const value_type& value
         ) {
-            throw std::logic_error("Not implemented");
+            // value may refer to one of our elements, which could be removed or relocated
+            const value_type copy = value;
+            _resize(count, [&](T* element) { TAllocator::construct(_allocator, element, copy); });
+        }
+        /*
+         * like resize(), but new elements of trivial types are left
+         * uninitialised (default-initialised) rather than zeroed, for when
+         * they're about to be overwritten anyway, e.g. by reading a file into
+         * them. Non-trivial types are default-inserted as by resize().
+         */
+        constexpr void resize_for_overwrite(size_type count) {
+            resize_for_overwrite({0, count});
+        }
+        constexpr void resize_for_overwrite(std::pair<size_type, size_type> count) {
+            _resize(count, [&](T* element) { _construct_for_overwrite(element); });
+        }
+        /*
+         * appends count elements as resize_for_overwrite() does, returning
+         * a span over them for filling in
+         */
+        constexpr std::span<T> append_uninitialized(size_type count) {
+            resize_for_overwrite(_size + count);
+            return {_storage.data + _base_index + _size - count, count};
+        }
+        /*
+         * destroys all elements and frees their storage, then takes ownership
+         * of the buffer of capacity elements at data, of which the size
+         * elements from index base must already be constructed. data must
+         * have been allocated by an allocator equal to get_allocator(), which
+         * will deallocate it in turn.
+         * Throws std::invalid_argument (leaving the sharray untouched) if the
+         * elements don't fit in the buffer.
+         */
+        constexpr void adopt(T* data, size_type capacity, size_type base, size_type size) {
+            if (base > capacity or size > capacity - base or (data == nullptr and capacity != 0)) {
+                throw std::invalid_argument("adopted elements must lie within the buffer");
+            }
+            _release_storage();
+            _storage = {data, capacity};
+            _base_index = base;
+            _size = size;
+            _front_pushes = 0;
+            _back_pushes = 0;
+        }
+        /*
+         * hands over the storage and all the elements in it, leaving the
+         * sharray empty with no capacity. The caller becomes responsible for
+         * destroying the elements and deallocating the storage with an
+         * allocator equal to get_allocator(), or passing it to adopt().
+         * Elements in a small_sharray's inline buffer are first moved into
+         * allocated storage, which is the only case that can throw.
+         */
+        [[nodiscard]] constexpr buffer release() {
+            if (_is_inline()) {
+                _reallocate(_size, 0);
+            }
+            buffer released = {_storage.data, _storage.size, _base_index, _size};
+            _storage = {};
+            _base_index = 0;
+            _size = 0;
+            _front_pushes = 0;
+            _back_pushes = 0;
+            return released;
         }
-        constexpr void swap(sharray& other) noexcept {
+        constexpr void swap(sharray& other) noexcept(_nothrow_move_assign()) {
+            if (_is_inline() or other._is_inline()) {
+                // inline buffers can't be swapped, so the elements must be moved across
+                sharray temporary(std::move(other));
+                other = std::move(*this);
+                *this = std::move(temporary);
+                return;
+            }
             if constexpr (TAllocator::propagate_on_container_swap::value) {
                 std::swap(_allocator, other._allocator);
             }
             std::swap(_storage, other._storage);
             std::swap(_base_index, other._base_index);
             std::swap(_size, other._size);
+            std::swap(_front_pushes, other._front_pushes);
+            std::swap(_back_pushes, other._back_pushes);
+        }
+        // lookup
+        // iterator to the first element equal to value, or end() if there isn't one
+        constexpr iterator find(const T& value) {
+            return _iterator_at(detail::find(begin(), _size, value));
+        }
+        constexpr const_iterator find(const T& value) const {
+            return begin() + static_cast<difference_type>(detail::find(begin(), _size, value));
+        }
+        constexpr size_type count(const T& value) const {
+            return detail::count(begin(), _size, value);
+        }
+        constexpr bool contains(const T& value) const {
+            return detail::find(begin(), _size, value) != _size;
         }
         // comparison
         constexpr bool operator==(const sharray& other) const {
             if (_size != other._size) { return false; }
+            if constexpr (is_trivially_equality_comparable_v<T>) {
+                if (not std::is_constant_evaluated()) {
+                    return _size == 0 or std::memcmp(
+                        static_cast<const void*>(begin()),
+                        static_cast<const void*>(other.begin()),
+                        _size * sizeof(T)
+                    ) == 0;
+                }
+            }
             for (size_type i = 0; i < _size; i++) {
                 if ((*this)[i] != other[i]) { return false; }
             }
             return true;
         }
+        constexpr auto operator<=>(const sharray& other) const
+        requires std::three_way_comparable<T> {
+            if constexpr (detail::is_byte_v<T>) {
+                // bytes compare the same way as memcmp() compares them
+                if (not std::is_constant_evaluated()) {
+                    size_type common = std::min(_size, other._size);
+                    int difference = common == 0 ? 0 : std::memcmp(
+                        static_cast<const void*>(begin()),
+                        static_cast<const void*>(other.begin()),
+                        common
+                    );
+                    return difference != 0 ? difference <=> 0 : _size <=> other._size;
+                }
+            }
+            return std::lexicographical_compare_three_way(
+                begin(), end(), other.begin(), other.end()
+            );
+        }
     private:
+        // save() records where the elements start in their storage
+        friend struct detail::sharray_file_access;
+
         // type used for allocating storage for T (in case the Allocator passed is for a different type)
         using TAllocator = std::allocator_traits<Allocator>::template rebind_traits<T>;
+        // a block of storage for elements and its size
+        struct Storage {
+            T* data = nullptr;
+            std::size_t size = 0;
+        };
+        /*
+         * allocates storage for at least count elements, using the inline
+         * buffer if the elements fit in it and it isn't already in use.
+         * The inline buffer is never used during constant evaluation, as
+         * objects can't be constructed in raw bytes then.
+         */
+        constexpr Storage _allocate_at_least(size_type count) {
+            if constexpr (InlineCapacity != 0) {
+                if (not std::is_constant_evaluated() and count <= InlineCapacity and not _is_inline()) {
+                    return {_inline.data(), InlineCapacity};
+                }
+            }
+            if (count == 0) { return {}; }
+            return {TAllocator::allocate(_allocator, count), count};
+        }
+        constexpr void _deallocate(Storage storage) {
+            if (storage.data == nullptr or _is_inline(storage.data)) { return; }
+            TAllocator::deallocate(_allocator, storage.data, storage.size);
+        }
+        // is the given storage (by default, the one in use) the inline buffer?
+        constexpr bool _is_inline(const T* data) const {
+            if constexpr (InlineCapacity != 0) {
+                if (not std::is_constant_evaluated()) {
+                    return data == _inline.data();
+                }
+            }
+            return false;
+        }
+        constexpr bool _is_inline() const {
+            return _is_inline(_storage.data);
+        }
+        // for use in constructors: allocates storage with room for count elements in the middle
+        constexpr void _allocate_centred(size_type count) {
+            _storage = _allocate_at_least(count);
+            _base_index = (_storage.size - count) / 2;
+        }
+        // destroys all elements and frees their storage, leaving the sharray empty with no capacity
+        constexpr void _release_storage() {
+            detail::destroy(_allocator, _storage.data + _base_index, _size);
+            _deallocate(_storage);
+            _storage = {};
+            _base_index = 0;
+            _size = 0;
+        }
+        // can _take_elements() be done without risk of an exception?
+        static constexpr bool _nothrow_take_elements() {
+            return InlineCapacity == 0 or detail::is_nothrow_relocatable_v<T>;
+        }
+        // can move assignment be done without risk of an exception?
+        static constexpr bool _nothrow_move_assign() {
+            return (
+                TAllocator::propagate_on_container_move_assignment::value or
+                TAllocator::is_always_equal::value
+            ) and _nothrow_take_elements();
+        }
+        /*
+         * takes over other's elements, leaving it empty. This sharray must have
+         * no storage, and our allocator must be able to deallocate other's.
+         * Storage is taken over directly unless it's other's inline buffer, in
+         * which case the elements are moved into our own inline buffer.
+         */
+        constexpr void _take_elements(sharray& other) {
+            if (other._is_inline()) {
+                _storage = _allocate_at_least(other._size);
+                // both inline buffers are the same size, so the same layout will do
+                _base_index = other._base_index;
+                detail::relocate(
+                    _allocator,
+                    other._storage.data + other._base_index,
+                    other._size,
+                    _storage.data + _base_index
+                );
+                _size = other._size;
+                // other keeps its inline buffer
+                other._size = 0;
+                other._base_index = other._storage.size / 2;
+                return;
+            }
+            _storage = other._storage;
+            _base_index = other._base_index;
+            _size = other._size;
+            other._storage = {};
+            other._base_index = 0;
+            other._size = 0;
+        }
         // accessors to the actual elements in the sharray, using span as a shortcut
         constexpr std::span<T> _elements() {
             return {_storage.data + _base_index, _size};
@@ -414,16 +752,462 @@ namespace com::saxbophone::codlili {
         constexpr size_type _capacity_ahead() const {
             return _storage.size - _base_index;
         }
-        // conditional reallocators for front and back insertions
-        constexpr void _grow_front(size_type extra_space) {
-            if (extra_space > _capacity_behind()) {
-                reserve((_size + extra_space) * 3);
+        // marker for "no such index"
+        static constexpr size_type _npos = std::numeric_limits<size_type>::max();
+        // converts between iterators and indices of the elements
+        constexpr size_type _index_of(const_iterator pos) const {
+            return static_cast<size_type>(pos - cbegin());
+        }
+        constexpr iterator _iterator_at(size_type index) {
+            return begin() + static_cast<difference_type>(index);
+        }
+        // how much storage to allocate when it has to grow to fit needed elements
+        constexpr size_type _grow_capacity(size_type needed) const {
+            /*
+             * if it already fits with enough spare (but couldn't be slid, as
+             * moving it might throw), just redistribute the spare space
+             */
+            if (needed <= _storage.size and _worth_sliding(_storage.size - needed)) {
+                return _storage.size;
+            }
+            return GrowthPolicy::capacity_for(needed, _storage.size);
+        }
+        /*
+         * is it worth sliding all elements along to leave this much spare?
+         * Sliding costs a move of every element, so only do it if it frees up
+         * space in proportion to that cost, otherwise an almost-full block
+         * would be slid on every push
+         */
+        constexpr bool _worth_sliding(size_type spare) const {
+            // the only alternative to sliding within the inline buffer is leaving it
+            return spare >= _size / 4 or _is_inline();
+        }
+        // can elements be slid along within the storage without risk of an exception?
+        static constexpr bool _can_slide() {
+            return detail::is_nothrow_relocatable_v<T>;
+        }
+        // moves all elements within the existing storage, so the first is at new_base
+        constexpr void _slide(size_type new_base) {
+            if constexpr (_can_slide()) {
+                detail::shift(
+                    _allocator,
+                    _storage.data + _base_index,
+                    _size,
+                    _storage.data + new_base
+                );
+                _base_index = new_base;
+            }
+        }
+        /*
+         * how much of the given spare space to put in front of the elements.
+         * This is split in proportion to the number of recent push_front()s
+         * and push_back()s, so that a sharray which mostly grows at one end
+         * doesn't waste space at the other. With no history, or a balanced
+         * one, the elements are centred.
+         */
+        constexpr size_type _headroom_front(size_type spare) const {
+            // add-one smoothing keeps a little space at an end that's rarely pushed to
+            size_type front_weight = _front_pushes + 1;
+            size_type total_weight = _front_pushes + _back_pushes + 2;
+            // divide first if multiplying would overflow
+            if (spare > std::numeric_limits<size_type>::max() / total_weight) {
+                return spare / total_weight * front_weight;
+            }
+            return spare * front_weight / total_weight;
+        }
+        /*
+         * inserts count elements before the one at index, by opening up a gap
+         * there and calling fill with a pointer to it, which must construct
+         * all the new elements in it or none at all (throwing an exception).
+         * The gap is made in place if there's room (see _gap_base()), otherwise
+         * by reallocating.
+         */
+        template <typename Fill>
+        constexpr void _insert_gap(size_type index, size_type count, Fill fill) {
+            size_type new_base = _gap_base(index, count);
+            if (new_base == _npos) {
+                size_type needed = _size + count;
+                size_type new_cap = _grow_capacity(needed);
+                return _reallocate(
+                    new_cap, _headroom_front(new_cap - needed), index, count, fill
+                );
+            }
+            size_type old_base = _base_index;
+            _shift_parts(index, 0, count, new_base);
+            try {
+                fill(_storage.data + _base_index + index);
+            } catch (...) {
+                // put everything back where it was
+                _shift_parts(index, count, 0, old_base);
+                throw;
+            }
+            _size += count;
+        }
+        // inserts the elements from first up to last before the one at index
+        template <std::input_iterator It, std::sentinel_for<It> Sentinel>
+        constexpr void _insert_range(size_type index, It first, Sentinel last) {
+            if constexpr (std::forward_iterator<It>) {
+                // the size of the range is known up front, so the gap can be opened in one go
+                size_type count = static_cast<size_type>(std::ranges::distance(first, last));
+                if (count != 0) {
+                    _insert_gap(index, count, [&](T* gap) {
+                        _construct_from(gap, first, count);
+                    });
+                }
+            } else {
+                // single-pass range of unknown size, so gather it up first
+                sharray buffer(_allocator);
+                for (; first != last; ++first) {
+                    buffer.emplace_back(*first);
+                }
+                _insert_range(
+                    index,
+                    std::make_move_iterator(buffer.begin()),
+                    std::make_move_iterator(buffer.end())
+                );
+            }
+        }
+        /*
+         * constructs count elements starting at destination from those
+         * starting at first, copying their bytes in one go if possible
+         */
+        template <std::input_iterator It>
+        constexpr void _construct_from(T* destination, It first, size_type count) {
+            if constexpr (
+                std::contiguous_iterator<It> and
+                std::is_same_v<std::iter_value_t<It>, T> and
+                std::is_trivially_copyable_v<T>
+            ) {
+                if (not std::is_constant_evaluated()) {
+                    if (count != 0) {
+                        std::memcpy(
+                            static_cast<void*>(destination),
+                            static_cast<const void*>(std::to_address(first)),
+                            count * sizeof(T)
+                        );
+                    }
+                    return;
+                }
+            }
+            _construct_each(destination, count, [&](T* element) {
+                TAllocator::construct(_allocator, element, *first);
+                ++first;
+            });
+        }
+        /*
+         * replaces all elements with count new ones, constructed in place by
+         * fill(pointer to first). Storage is reused if it's big enough,
+         * otherwise the new elements are built in new storage before ours is
+         * freed, so the sharray is unchanged if that throws.
+         */
+        template <typename Fill>
+        constexpr void _assign(size_type count, Fill fill) {
+            if (count > capacity()) {
+                sharray replacement(_allocator);
+                replacement._allocate_centred(count);
+                fill(replacement._storage.data + replacement._base_index);
+                replacement._size = count;
+                _release_storage();
+                _take_elements(replacement);
+                return;
+            }
+            detail::destroy(_allocator, _storage.data + _base_index, _size);
+            _size = 0;
+            _base_index = (_storage.size - count) / 2;
+            fill(_storage.data + _base_index);
+            _size = count;
+        }
+        // inserts a single element constructed from args before the one at index
+        template <class... Args>
+        constexpr void _emplace_at(size_type index, Args&&... args) {
+            size_type new_base = _gap_base(index, 1);
+            bool moves = new_base == _npos ? _can_remap() : _moves_elements(index, 1, new_base);
+            if (moves) {
+                // args may refer to one of the elements that will be moved, so construct it first
+                value_type value(std::forward<Args>(args)...);
+                _insert_gap(index, 1, [&](T* gap) {
+                    TAllocator::construct(_allocator, gap, std::move(value));
+                });
+            } else {
+                // when reallocating, the new element is constructed before the old ones are moved
+                _insert_gap(index, 1, [&](T* gap) {
+                    TAllocator::construct(_allocator, gap, std::forward<Args>(args)...);
+                });
+            }
+        }
+        /*
+         * where the first element should be moved to in order to open a gap
+         * for count elements before the one at index without reallocating, or
+         * _npos if that's not possible. Whichever side of index has fewer
+         * elements is shifted to make the gap, or if there's no room on that
+         * side, all elements are slid along to spread out the spare space.
+         */
+        constexpr size_type _gap_base(size_type index, size_type count) const {
+            size_type room_front = _capacity_behind();
+            size_type room_back = _capacity_ahead() - _size;
+            // inserting at either end doesn't move anything, so is always possible given room
+            if (index == _size and count <= room_back) { return _base_index; }
+            if (index == 0 and count <= room_front) { return _base_index - count; }
+            if (not _can_slide()) { return _npos; }
+            if (index <= _size - index) {
+                if (count <= room_front) { return _base_index - count; }
+            } else if (count <= room_back) {
+                return _base_index;
+            }
+            if (count <= room_front + room_back) {
+                size_type spare = room_front + room_back - count;
+                if (_worth_sliding(spare)) {
+                    return _headroom_front(spare);
+                }
+            }
+            return _npos;
+        }
+        // would opening a gap for count elements at index by moving the first to new_base move any elements?
+        constexpr bool _moves_elements(
+            size_type index, size_type count, size_type new_base
+        ) const {
+            return (index != 0 and new_base != _base_index)
+                or (index != _size and new_base + count != _base_index);
+        }
+        /*
+         * changes the size of the gap between the elements before index and
+         * those after it from old_gap to new_gap (without constructing or
+         * destroying anything in it), moving the elements within the storage
+         * so that the first one ends up at new_base.
+         * For types which can't be slid along, only opening and closing gaps
+         * at the ends (which moves nothing) is supported.
+         */
+        constexpr void _shift_parts(
+            size_type index, size_type old_gap, size_type new_gap, size_type new_base
+        ) {
+            if constexpr (_can_slide()) {
+                T* left = _storage.data + _base_index;
+                T* right = left + index + old_gap;
+                T* new_left = _storage.data + new_base;
+                T* new_right = new_left + index + new_gap;
+                // move whichever part is going up first, so neither part overwrites the other
+                if (new_right > right) {
+                    detail::shift(_allocator, right, _size - index, new_right);
+                    detail::shift(_allocator, left, index, new_left);
+                } else {
+                    detail::shift(_allocator, left, index, new_left);
+                    detail::shift(_allocator, right, _size - index, new_right);
+                }
+            }
+            _base_index = new_base;
+        }
+        // constructs count elements by calling construct with each of their addresses in turn, all or nothing
+        template <typename Construct>
+        constexpr void _construct_each(
+            T* destination, size_type count, Construct construct
+        ) {
+            size_type constructed = 0;
+            try {
+                for (; constructed < count; constructed++) {
+                    construct(destination + constructed);
+                }
+            } catch (...) {
+                detail::destroy(_allocator, destination, constructed);
+                throw;
+            }
+        }
+        // moves the elements into new storage of new_cap elements, or frees it all if that's 0
+        constexpr void _shrink(size_type new_cap, size_type new_base) {
+            if (new_cap == 0) {
+                _release_storage();
+            } else {
+                _reallocate(new_cap, new_base);
+            }
+        }
+        /*
+         * if GrowthPolicy asks for it (see auto_shrink), shrinks the storage
+         * after elements have been removed
+         */
+        constexpr void _shrink_if_sparse() noexcept {
+            if constexpr (shrinking_growth_policy<GrowthPolicy>) {
+                if (_is_inline()) { return; }
+                size_type new_cap = GrowthPolicy::shrink_capacity_for(_size, _storage.size);
+                if (new_cap >= _storage.size) { return; }
+                try {
+                    _shrink(new_cap, _headroom_front(new_cap - _size));
+                } catch (...) {
+                    // shrinking is only an optimisation, so if it fails the elements just stay put
+                }
+            }
+        }
+        // implements resize(), constructing each new element with construct(pointer)
+        template <typename Construct>
+        constexpr void _resize(std::pair<size_type, size_type> count, Construct construct) {
+            auto [before, after] = count;
+            if (after < _size) {
+                detail::destroy(_allocator, _storage.data + _base_index + after, _size - after);
+                _size = after;
+                if (_size == 0) {
+                    _base_index = _storage.size / 2; // so the array can grow either way again
+                }
+                if (before == 0) {
+                    _shrink_if_sparse();
+                }
+            }
+            // allocate the space needed on both sides in one go
+            reserve({before, after});
+            size_type appended = after - _size;
+            _construct_each(_storage.data + _base_index + _size, appended, construct);
+            _size = after;
+            _construct_each(_storage.data + _base_index - before, before, construct);
+            _base_index -= before;
+            _size += before;
+            _back_pushes += appended;
+            _front_pushes += before;
+        }
+        /*
+         * default-initialises a new element if T is trivial, so that it's left
+         * uninitialised, otherwise default-inserts it using the allocator
+         */
+        constexpr void _construct_for_overwrite(T* element) {
+            if constexpr (std::is_trivially_default_constructible_v<T>) {
+                if (not std::is_constant_evaluated()) {
+                    ::new (static_cast<void*>(element)) T;
+                    return;
+                }
+            }
+            TAllocator::construct(_allocator, element);
+        }
+        /*
+         * moves all elements into a newly-allocated block of new_cap elements,
+         * with the first element placed at index new_base of the new block.
+         * Every reallocating operation goes through here, so that elements are
+         * always moved rather than copied where this is safe, and trivially
+         * relocatable elements are moved as a single block.
+         */
+        constexpr void _reallocate(size_type new_cap, size_type new_base) {
+            _reallocate(new_cap, new_base, _size, 0, [](T*) {});
+        }
+        /*
+         * as above, but also leaves a gap of gap_count elements before the
+         * element at gap_index, which is filled by calling fill with a pointer
+         * to it before the existing elements are moved (in case they're what
+         * the new ones are being constructed from), unless they're remapped
+         * instead (see _remap()). fill must construct all new elements or none
+         * of them (throwing).
+         */
+        template <typename Fill>
+        constexpr void _reallocate(
+            size_type new_cap,
+            size_type new_base,
+            size_type gap_index,
+            size_type gap_count,
+            Fill fill
+        ) {
+            if constexpr (_can_remap()) {
+                if (_remap(new_cap, new_base, gap_index, gap_count, fill)) { return; }
+            }
+            Storage new_storage = _allocate_at_least(new_cap);
+            T* source = _storage.data + _base_index;
+            T* destination = new_storage.data + new_base;
+            size_type after = _size - gap_index;
+            try {
+                fill(destination + gap_index);
+                try {
+                    if constexpr (detail::is_nothrow_relocatable_v<T>) {
+                        detail::relocate(_allocator, source, gap_index, destination);
+                        detail::relocate(
+                            _allocator,
+                            source + gap_index,
+                            after,
+                            destination + gap_index + gap_count
+                        );
+                    } else {
+                        // both parts must be copied before any of the originals can be destroyed
+                        detail::uninitialized_move_if_noexcept(
+                            _allocator, source, gap_index, destination
+                        );
+                        try {
+                            detail::uninitialized_move_if_noexcept(
+                                _allocator,
+                                source + gap_index,
+                                after,
+                                destination + gap_index + gap_count
+                            );
+                        } catch (...) {
+                            detail::destroy(_allocator, destination, gap_index);
+                            throw;
+                        }
+                        detail::destroy(_allocator, source, _size);
+                    }
+                } catch (...) {
+                    detail::destroy(_allocator, destination + gap_index, gap_count);
+                    throw;
+                }
+            } catch (...) {
+                // old storage is untouched, so only the new block needs freeing
+                _deallocate(new_storage);
+                throw;
+            }
+            // swap new storage with old
+            std::swap(new_storage, _storage);
+            _base_index = new_base;
+            _size += gap_count;
+            // halve the push history so it tracks recent behaviour
+            _front_pushes /= 2;
+            _back_pushes /= 2;
+            // deallocate old storage
+            _deallocate(new_storage);
+        }
+
+        // can storage be grown by remapping it rather than moving the elements?
+        static constexpr bool _can_remap() {
+            if constexpr (remapping_allocator<Allocator>) {
+                return std::is_same_v<typename Allocator::value_type, T>
+                    and is_trivially_relocatable_v<T>;
             }
+            return false;
         }
-        constexpr void _grow_back(size_type extra_space) {
-            if (extra_space > _capacity_ahead()) {
-                reserve((_size + extra_space) * 3);
+        /*
+         * _reallocate() for allocators which can remap storage, when the gap is
+         * at either end. The old block is remapped into the new one whole, so
+         * none of the elements are copied, at the first offset the allocator
+         * supports at or after where the elements should go. The new block is
+         * enlarged by however far past that is, so there's still as much room
+         * at both ends as asked for. The space before that offset is never
+         * touched unless elements are pushed into it.
+         * The new elements are constructed in the remapped block, after the
+         * existing ones have moved, so fill mustn't refer to them. If fill
+         * throws, the elements are left in the remapped block.
+         * Returns false without changing anything if the old block doesn't fit.
+         */
+        template <typename Fill>
+        constexpr bool _remap(
+            size_type new_cap,
+            size_type new_base,
+            size_type gap_index,
+            size_type gap_count,
+            Fill fill
+        ) {
+            if (std::is_constant_evaluated() or _storage.data == nullptr or _is_inline()) {
+                return false;
+            }
+            if (gap_index != 0 and gap_index != _size) { return false; }
+            bool front = gap_index == 0 and _size != 0;
+            // where the first existing element should end up, and where it can
+            size_type target = new_base + (front ? gap_count : 0);
+            if (target < _base_index) { return false; }
+            size_type step = std::lcm(Allocator::remap_granularity(), sizeof(T)) / sizeof(T);
+            size_type offset = (target - _base_index + step - 1) / step * step;
+            size_type first = _base_index + offset;
+            new_cap += first - target;
+            if (offset + _storage.size > new_cap) { return false; }
+            T* data = _allocator.reallocate(_storage.data, _storage.size, new_cap, offset);
+            _storage = {data, new_cap};
+            _base_index = first;
+            if (gap_count != 0) {
+                fill(data + (front ? first - gap_count : first + _size));
+                _base_index = front ? first - gap_count : first;
             }
+            _size += gap_count;
+            _front_pushes /= 2;
+            _back_pushes /= 2;
+            return true;
         }
 
         allocator_type _allocator = Allocator();
@@ -432,11 +1216,15 @@ namespace com::saxbophone::codlili {
          * - _storage_size can be greater than _size
          * - _storage_size MUST NOT be less than _base_index + _size
          * - we initialise _base_index to be halfway through _storage
-         * - every time we need to re-allocate storage to resize, we maintain
-         * _base_index to be halfway through _storage
+         * - every time we need to re-allocate storage to resize, we split the
+         * spare space between front and back in proportion to recent pushes at
+         * each end (which is halfway through _storage when they're balanced)
          * - we avoid the need to always resize on push_front by shifting
          * _base_index down to move the "start" of the array down by one element
          * and hence also avoid needing to move the other elements
+         * - when one end runs out of space but there's plenty spare at the
+         * other, the elements are slid along within _storage instead of
+         * reallocating (only for types which can be relocated without throwing)
          * IMPLEMENTATION NOTES:
          * - if we really want to, we can use std::span to simplify element
          * access by making an "elements" span for the subset of storage that is
@@ -453,13 +1241,21 @@ namespace com::saxbophone::codlili {
          * violates the implication that unused allocated storage is... well,
          * allocated but unused (i.e. allocated but not constructed).
          */
-        struct {
-            T* data = nullptr; // heap-allocated array for storing elements in and its size, wrapped in a span
-            std::size_t size = 0;
-        } _storage;
+        Storage _storage; // allocated (or inline) array for storing elements in
+        // space for storing elements within the sharray itself (empty if InlineCapacity is 0)
+        [[no_unique_address]] detail::inline_buffer<T, InlineCapacity> _inline;
         std::size_t _base_index = 0; // 0-based index of first element in _storage to use
         std::size_t _size = 0; // number of stored items
+        // number of recent pushes at each end, used to decide where to put spare space when growing
+        std::size_t _front_pushes = 0;
+        std::size_t _back_pushes = 0;
     };
+
+    namespace pmr {
+        // sharray using a std::pmr::memory_resource, such as an arena, for storage
+        template <typename T, growth_policy GrowthPolicy = default_growth>
+        using sharray = codlili::sharray<T, std::pmr::polymorphic_allocator<T>, GrowthPolicy>;
+    }
 }
 
 #endif
@@ -0,0 +1,159 @@
+/*
+ * Created by Joshua Saxby <joshua.a.saxby@gmail.com>, October 2026
+ * Copyright Joshua Saxby <joshua.a.saxby@gmail.com> 2026
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef COM_SAXBOPHONE_CODLILI_SHARRAY_FILE_HPP
+#define COM_SAXBOPHONE_CODLILI_SHARRAY_FILE_HPP
+
+#include <cstddef>          // size_t
+#include <cstdint>          // uint32_t, uint64_t
+#include <cstring>          // memcmp, memcpy
+
+#include <algorithm>        // max
+#include <filesystem>       // path
+#include <fstream>          // ofstream
+#include <ios>              // streamsize
+#include <type_traits>      // is_trivially_copyable_v
+
+#include <codlili/growth_policy.hpp>
+#include <codlili/sharray.hpp>
+
+
+namespace com::saxbophone::codlili {
+    /**
+     * @brief The header at the start of a file written by `save()`
+     * @details A sharray file is laid out as follows, with all fields in the
+     * byte order of the machine that wrote it:
+     * - this header, in the order its fields are declared, with no padding
+     * - zero bytes up to `data_offset`, which is a multiple of both 64 and
+     *   the alignment of the elements, so they're aligned when mapped
+     * - `size` elements of `element_size` bytes each, copied byte-for-byte
+     *   from memory, so only trivially copyable types can be saved
+     *
+     * `base_index` records how much space the sharray had before its front,
+     * so that it can be recreated with the same layout.
+     * A file is only readable (see `mapped_sharray`) as elements of the same
+     * size and alignment by a machine with the same byte order as the one
+     * that wrote it, which `byte_order` is checked against.
+     */
+    struct sharray_file_header {
+        static constexpr char MAGIC[8] = {'c', 'o', 'd', 'l', 'i', 'l', 'i', '\0'};
+        static constexpr std::uint32_t VERSION = 1;
+        // reads back differently on a machine with a different byte order
+        static constexpr std::uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t byte_order;
+        std::uint64_t element_size;
+        std::uint64_t element_alignment;
+        std::uint64_t base_index;
+        std::uint64_t size;
+        std::uint64_t data_offset;
+
+        // a header for a file holding size elements of T
+        template <typename T>
+        static sharray_file_header describing(std::size_t size, std::size_t base_index) {
+            sharray_file_header header = {};
+            std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+            header.version = VERSION;
+            header.byte_order = BYTE_ORDER_MARK;
+            header.element_size = sizeof(T);
+            header.element_alignment = alignof(T);
+            header.base_index = base_index;
+            header.size = size;
+            std::size_t alignment = std::max<std::size_t>(64, alignof(T));
+            header.data_offset = (sizeof(sharray_file_header) + alignment - 1) / alignment * alignment;
+            return header;
+        }
+
+        /*
+         * does this header describe a file of elements of T that's file_size
+         * bytes long, written by a machine with our byte order?
+         */
+        template <typename T>
+        bool describes(std::uint64_t file_size) const {
+            return std::memcmp(magic, MAGIC, sizeof(MAGIC)) == 0
+                and version == VERSION
+                and byte_order == BYTE_ORDER_MARK
+                and element_size == sizeof(T)
+                and element_alignment == alignof(T)
+                and data_offset % alignof(T) == 0
+                and data_offset <= file_size
+                and size <= (file_size - data_offset) / sizeof(T);
+        }
+    };
+
+    static_assert(sizeof(sharray_file_header) == 56, "sharray file headers must not be padded");
+
+    namespace detail {
+        /*
+         * writes size elements from data to the file at path in the format
+         * described by sharray_file_header, replacing anything already there.
+         * Throws std::ios_base::failure if the file can't be written.
+         */
+        template <typename T>
+        void write_sharray_file(
+            const std::filesystem::path& path,
+            const T* data,
+            std::size_t size,
+            std::size_t base_index
+        ) {
+            auto header = sharray_file_header::describing<T>(size, base_index);
+            std::ofstream file;
+            file.exceptions(std::ofstream::failbit | std::ofstream::badbit);
+            file.open(path, std::ios::binary | std::ios::trunc);
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            for (std::size_t i = sizeof(header); i < header.data_offset; i++) {
+                file.put('\0');
+            }
+            if (size != 0) {
+                file.write(
+                    reinterpret_cast<const char*>(data),
+                    static_cast<std::streamsize>(size * sizeof(T))
+                );
+            }
+            file.close();
+        }
+
+        // the parts of a sharray's layout which save() records, but which aren't public
+        struct sharray_file_access {
+            template <
+                typename T,
+                class Allocator,
+                growth_policy GrowthPolicy,
+                std::size_t InlineCapacity
+            >
+            static std::size_t base_index(
+                const sharray<T, Allocator, GrowthPolicy, InlineCapacity>& array
+            ) noexcept {
+                return array._base_index;
+            }
+        };
+    }
+
+    /**
+     * @brief Writes the elements of a sharray to the file at path
+     * @details The file is in the format described by sharray_file_header,
+     * which mapped_sharray can read back in place. Anything already at path
+     * is replaced.
+     * @throws std::ios_base::failure if the file can't be written
+     */
+    template <typename T, class Allocator, growth_policy GrowthPolicy, std::size_t InlineCapacity>
+    requires std::is_trivially_copyable_v<T>
+    void save(
+        const sharray<T, Allocator, GrowthPolicy, InlineCapacity>& array,
+        const std::filesystem::path& path
+    ) {
+        detail::write_sharray_file(
+            path, array.data(), array.size(), detail::sharray_file_access::base_index(array)
+        );
+    }
+}
+
+#endif
@@ -0,0 +1,55 @@
+/*
+ * Created by Joshua Saxby <joshua.a.saxby@gmail.com>, October 2026
+ * Copyright Joshua Saxby <joshua.a.saxby@gmail.com> 2026
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef COM_SAXBOPHONE_CODLILI_SMALL_SHARRAY_HPP
+#define COM_SAXBOPHONE_CODLILI_SMALL_SHARRAY_HPP
+
+#include <cstddef>          // size_t
+
+#include <memory>           // allocator
+#include <memory_resource>  // polymorphic_allocator
+
+#include <codlili/growth_policy.hpp>
+#include <codlili/sharray.hpp>
+
+
+namespace com::saxbophone::codlili {
+    /**
+     * @brief A sharray which stores up to N elements without allocating
+     * @details small_sharray keeps a buffer for N elements inside the object
+     * itself, and only allocates storage from Allocator once it needs to hold
+     * more than that. It has exactly the same interface as sharray.
+     * @note Moving or swapping a small_sharray whose elements are stored
+     * inline has to move the elements individually, so is O(N) rather than
+     * O(1), and can only throw if moving T can.
+     * @note The inline buffer is not used during constant evaluation, as
+     * elements can't be constructed in raw storage then, so small_sharray
+     * still works in constant expressions but allocates like sharray does.
+     * @tparam T the type of elements to store
+     * @tparam N how many elements can be stored without allocating
+     * @tparam Allocator the allocator to use once more than N elements are stored
+     * @tparam GrowthPolicy decides how much storage to allocate when full
+     */
+    template <
+        typename T,
+        std::size_t N,
+        class Allocator = std::allocator<T>,
+        growth_policy GrowthPolicy = default_growth
+    >
+    using small_sharray = sharray<T, Allocator, GrowthPolicy, N>;
+
+    namespace pmr {
+        template <typename T, std::size_t N, growth_policy GrowthPolicy = default_growth>
+        using small_sharray = codlili::small_sharray<
+            T, N, std::pmr::polymorphic_allocator<T>, GrowthPolicy
+        >;
+    }
+}
+
+#endif
@@ -0,0 +1,271 @@
+/*
+ * Created by Joshua Saxby <joshua.a.saxby@gmail.com>, October 2026
+ * Copyright Joshua Saxby <joshua.a.saxby@gmail.com> 2026
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef COM_SAXBOPHONE_CODLILI_STATIC_SHARRAY_HPP
+#define COM_SAXBOPHONE_CODLILI_STATIC_SHARRAY_HPP
+
+#include <cstddef>          // ptrdiff_t, size_t
+
+#include <algorithm>        // equal, min, move, move_backward
+#include <array>            // array
+#include <initializer_list> // initializer_list
+#include <iterator>         // input_iterator, reverse_iterator
+#include <stdexcept>        // length_error, out_of_range
+#include <type_traits>      // is_nothrow_swappable_v
+#include <utility>          // forward, move, swap
+
+
+namespace com::saxbophone::codlili {
+    /**
+     * @brief A fixed-capacity sharray which never allocates
+     * @details static_sharray supports insertion and removal at both the
+     * front and end like sharray, but stores up to Capacity elements inside
+     * the object itself. It has no allocator, and every operation can be
+     * used in constant expressions, so an instance built at compile time can
+     * be kept in a `constexpr` variable and used at runtime without any
+     * startup cost.
+     * Operations which would need more than Capacity elements throw
+     * `std::length_error`.
+     * @note So that instances can be constant expressions, all Capacity
+     * elements always exist: unused ones are value-initialised. T must
+     * therefore be default-constructible and move-assignable, and elements
+     * are assigned rather than constructed when inserted.
+     * @tparam T the type of elements to store
+     * @tparam Capacity the maximum number of elements that can be stored
+     */
+    template <typename T, std::size_t Capacity>
+    class static_sharray {
+    public:
+        using value_type = T;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using reference = T&;
+        using const_reference = const T&;
+        using pointer = T*;
+        using const_pointer = const T*;
+        using iterator = T*;
+        using const_iterator = const T*;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+        // member functions
+        constexpr static_sharray() = default;
+        constexpr static_sharray(size_type count, const T& value) {
+            _make_room(0, count);
+            for (size_type i = 0; i < count; i++) {
+                _storage[_base_index + i] = value;
+            }
+            _size = count;
+        }
+        constexpr explicit static_sharray(size_type count)
+          : static_sharray(count, T()) {}
+        template<std::input_iterator InputIt>
+        constexpr static_sharray(InputIt first, InputIt last) {
+            for (; first != last; first++) {
+                push_back(*first);
+            }
+        }
+        constexpr static_sharray(std::initializer_list<T> init)
+          : static_sharray(init.begin(), init.end()) {}
+
+        constexpr reference at(size_type pos) {
+            if (pos >= _size) { throw std::out_of_range("static_sharray::at"); }
+            return (*this)[pos];
+        }
+        constexpr const_reference at(size_type pos) const {
+            if (pos >= _size) { throw std::out_of_range("static_sharray::at"); }
+            return (*this)[pos];
+        }
+        constexpr reference operator[](size_type pos) {
+            return _storage[_base_index + pos];
+        }
+        constexpr const_reference operator[](size_type pos) const {
+            return _storage[_base_index + pos];
+        }
+        constexpr reference front() { return (*this)[0]; }
+        constexpr const_reference front() const { return (*this)[0]; }
+        constexpr reference back() { return (*this)[_size - 1]; }
+        constexpr const_reference back() const { return (*this)[_size - 1]; }
+        constexpr T* data() noexcept { return _storage.data() + _base_index; }
+        constexpr const T* data() const noexcept { return _storage.data() + _base_index; }
+
+        constexpr iterator begin() noexcept { return data(); }
+        constexpr const_iterator begin() const noexcept { return data(); }
+        constexpr const_iterator cbegin() const noexcept { return begin(); }
+        constexpr iterator end() noexcept { return begin() + _size; }
+        constexpr const_iterator end() const noexcept { return begin() + _size; }
+        constexpr const_iterator cend() const noexcept { return end(); }
+        constexpr reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+        constexpr const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+        constexpr const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+        constexpr reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+        constexpr const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+        constexpr const_reverse_iterator crend() const noexcept { return rend(); }
+
+        [[nodiscard]] constexpr bool empty() const noexcept {
+            return _size == 0;
+        }
+        constexpr size_type size() const noexcept { return _size; }
+        static constexpr size_type max_size() noexcept { return Capacity; }
+        static constexpr size_type capacity() noexcept { return Capacity; }
+
+        constexpr void clear() {
+            _reset(0, _size);
+            _size = 0;
+            _base_index = Capacity / 2;
+        }
+        constexpr iterator insert(const_iterator pos, const T& value) {
+            return emplace(pos, value);
+        }
+        constexpr iterator insert(const_iterator pos, T&& value) {
+            return emplace(pos, std::move(value));
+        }
+        template<class... Args>
+        constexpr iterator emplace(const_iterator pos, Args&&... args) {
+            size_type index = _index_of(pos);
+            // made first, as args may refer to an element that gets moved
+            T value(std::forward<Args>(args)...);
+            if (index < _size - index) { // fewer elements in front of pos to move
+                _make_room(1, 0);
+                _base_index--;
+                _size++;
+                std::move(begin() + 1, begin() + 1 + index, begin());
+            } else {
+                _make_room(0, 1);
+                _size++;
+                std::move_backward(begin() + index, end() - 1, end());
+            }
+            (*this)[index] = std::move(value);
+            return begin() + index;
+        }
+        constexpr iterator erase(const_iterator pos) {
+            return erase(pos, pos + 1);
+        }
+        constexpr iterator erase(const_iterator first, const_iterator last) {
+            size_type index = _index_of(first);
+            size_type count = _index_of(last) - index;
+            if (count == 0) { return begin() + index; }
+            if (index < _size - index - count) { // fewer elements in front of the range to move
+                std::move_backward(begin(), begin() + index, begin() + index + count);
+                _reset(0, count);
+                _base_index += count;
+            } else {
+                std::move(begin() + index + count, end(), begin() + index);
+                _reset(_size - count, count);
+            }
+            _size -= count;
+            return begin() + index;
+        }
+        constexpr void push_back(const T& value) {
+            emplace_back(value);
+        }
+        constexpr void push_back(T&& value) {
+            emplace_back(std::move(value));
+        }
+        template<class... Args>
+        constexpr reference emplace_back(Args&&... args) {
+            T value(std::forward<Args>(args)...);
+            _make_room(0, 1);
+            _storage[_base_index + _size] = std::move(value);
+            _size++;
+            return back();
+        }
+        constexpr void pop_back() {
+            _reset(_size - 1, 1);
+            _size--;
+        }
+        constexpr void push_front(const T& value) {
+            emplace_front(value);
+        }
+        constexpr void push_front(T&& value) {
+            emplace_front(std::move(value));
+        }
+        template<class... Args>
+        constexpr reference emplace_front(Args&&... args) {
+            T value(std::forward<Args>(args)...);
+            _make_room(1, 0);
+            _base_index--;
+            _storage[_base_index] = std::move(value);
+            _size++;
+            return front();
+        }
+        constexpr void pop_front() {
+            _reset(0, 1);
+            _base_index++;
+            _size--;
+        }
+        constexpr void resize(size_type count) {
+            resize(count, T());
+        }
+        constexpr void resize(size_type count, const value_type& value) {
+            if (count < _size) {
+                _reset(count, _size - count);
+            } else {
+                _make_room(0, count - _size);
+                for (size_type i = _size; i < count; i++) {
+                    (*this)[i] = value;
+                }
+            }
+            _size = count;
+        }
+        constexpr void swap(static_sharray& other) noexcept(std::is_nothrow_swappable_v<T>) {
+            std::swap(_storage, other._storage);
+            std::swap(_base_index, other._base_index);
+            std::swap(_size, other._size);
+        }
+
+        constexpr bool operator==(const static_sharray& other) const {
+            return std::equal(begin(), end(), other.begin(), other.end());
+        }
+    private:
+        constexpr size_type _index_of(const_iterator pos) const {
+            return static_cast<size_type>(pos - begin());
+        }
+        // resets count elements starting at index to T(), releasing anything they hold
+        constexpr void _reset(size_type index, size_type count) {
+            for (size_type i = 0; i < count; i++) {
+                (*this)[index + i] = T();
+            }
+        }
+        /*
+         * makes sure there are at least front spare elements before the first
+         * element and back after the last, moving the elements to the middle
+         * of the remaining space if not
+         */
+        constexpr void _make_room(size_type front, size_type back) {
+            if (front <= _base_index and back <= Capacity - _base_index - _size) {
+                return;
+            }
+            if (front + back > Capacity - _size) {
+                throw std::length_error("static_sharray capacity exceeded");
+            }
+            size_type new_base = front + (Capacity - _size - front - back) / 2;
+            if (new_base < _base_index) {
+                std::move(begin(), end(), _storage.data() + new_base);
+                // the old positions of the last elements are no longer in use
+                size_type vacated = std::min(_base_index - new_base, _size);
+                for (size_type i = 0; i < vacated; i++) {
+                    _storage[_base_index + _size - 1 - i] = T();
+                }
+            } else {
+                std::move_backward(begin(), end(), _storage.data() + new_base + _size);
+                size_type vacated = std::min(new_base - _base_index, _size);
+                for (size_type i = 0; i < vacated; i++) {
+                    _storage[_base_index + i] = T();
+                }
+            }
+            _base_index = new_base;
+        }
+
+        std::array<T, Capacity> _storage = {}; // all elements, used and unused
+        size_type _base_index = Capacity / 2; // index of front element in _storage
+        size_type _size = 0;
+    };
+}
+
+#endif
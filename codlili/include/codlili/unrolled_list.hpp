@@ -0,0 +1,595 @@
+/*
+ * Created by Joshua Saxby <joshua.a.saxby@gmail.com>, October 2026
+ * Copyright Joshua Saxby <joshua.a.saxby@gmail.com> 2026
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef COM_SAXBOPHONE_CODLILI_UNROLLED_LIST_HPP
+#define COM_SAXBOPHONE_CODLILI_UNROLLED_LIST_HPP
+
+#include <cstddef>          // ptrdiff_t, size_t
+
+#include <algorithm>        // equal, lexicographical_compare_three_way, max
+#include <compare>          // three_way_comparable
+#include <initializer_list> // initializer_list
+#include <iterator>         // bidirectional_iterator_tag, distance, input_iterator, reverse_iterator
+#include <limits>           // numeric_limits
+#include <memory>           // allocator, allocator_traits, construct_at, destroy_at
+#include <type_traits>      // conditional_t, is_nothrow_move_constructible_v
+#include <utility>          // forward, move, pair, swap
+
+
+namespace com::saxbophone::codlili {
+    namespace detail {
+        // the default chunk size of unrolled_list<T>: nodes of about 256 bytes, but at least 4 elements
+        template <typename T>
+        inline constexpr std::size_t default_unrolled_chunk_size = std::max<std::size_t>(256 / sizeof(T), 4);
+
+        // links of a node of unrolled_list, and of the node one past the end, which holds no elements
+        struct unrolled_links {
+            unrolled_links* prev = nullptr;
+            unrolled_links* next = nullptr;
+        };
+
+        /*
+         * a node of unrolled_list, holding up to ChunkSize elements. They're
+         * kept in the slots [first, first + count), so that there can be room
+         * at both ends, and the slots are a union so that the ones outside of
+         * that range don't hold constructed elements.
+         */
+        template <typename T, std::size_t ChunkSize>
+        struct unrolled_node : unrolled_links {
+            union slot {
+                constexpr slot() {}
+                constexpr ~slot() {}
+                T value;
+            };
+
+            constexpr unrolled_node() {}
+            unrolled_node(const unrolled_node&) = delete;
+            unrolled_node& operator=(const unrolled_node&) = delete;
+            constexpr ~unrolled_node() {}
+
+            // the storage for the element at index within this node
+            constexpr T* at(std::size_t index) { return &slots[first + index].value; }
+
+            std::size_t first = 0;
+            std::size_t count = 0;
+            slot slots[ChunkSize];
+        };
+
+        // iterator of unrolled_list, which refers to an element by its node and index within it
+        template <typename T, std::size_t ChunkSize, bool Const>
+        class unrolled_iterator {
+        private:
+            using Node = unrolled_node<T, ChunkSize>;
+        public:
+            using iterator_category = std::bidirectional_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = std::conditional_t<Const, const T*, T*>;
+            using reference = std::conditional_t<Const, const T&, T&>;
+
+            constexpr unrolled_iterator() = default;
+            constexpr unrolled_iterator(unrolled_links* node, std::size_t index)
+              : _node(node)
+              , _index(index)
+              {}
+            constexpr unrolled_iterator(const unrolled_iterator&) = default;
+            constexpr unrolled_iterator& operator=(const unrolled_iterator&) = default;
+            // iterator converts to const_iterator
+            constexpr unrolled_iterator(const unrolled_iterator<T, ChunkSize, false>& other)
+            requires Const
+              : _node(other._node)
+              , _index(other._index)
+              {}
+
+            constexpr reference operator*() const { return *static_cast<Node*>(_node)->at(_index); }
+            constexpr pointer operator->() const { return &**this; }
+
+            constexpr unrolled_iterator& operator++() {
+                if (++_index == static_cast<Node*>(_node)->count) {
+                    _node = _node->next;
+                    _index = 0;
+                }
+                return *this;
+            }
+            constexpr unrolled_iterator operator++(int) { auto old = *this; ++*this; return old; }
+            constexpr unrolled_iterator& operator--() {
+                if (_index == 0) {
+                    _node = _node->prev;
+                    _index = static_cast<Node*>(_node)->count;
+                }
+                _index--;
+                return *this;
+            }
+            constexpr unrolled_iterator operator--(int) { auto old = *this; --*this; return old; }
+            friend constexpr bool operator==(
+                const unrolled_iterator& lhs, const unrolled_iterator& rhs
+            ) {
+                return lhs._node == rhs._node and lhs._index == rhs._index;
+            }
+
+            // where the element is, for unrolled_list to insert and erase at
+            constexpr unrolled_links* node() const { return _node; }
+            constexpr std::size_t index() const { return _index; }
+        private:
+            template <typename, std::size_t, bool>
+            friend class unrolled_iterator;
+
+            unrolled_links* _node = nullptr;
+            std::size_t _index = 0; // always less than the node's count, or 0 for the end
+        };
+    }
+
+    /**
+     * @brief A doubly-linked list of nodes which each hold up to ChunkSize elements
+     * @details Traversing a `list` touches a whole node, with its two links,
+     * for every element, and the nodes can be anywhere in memory.
+     * unrolled_list keeps ChunkSize elements next to each other in each node,
+     * so traversal mostly reads consecutive memory, and there are ChunkSize
+     * times fewer links and allocations. Insertion and erasure at an iterator
+     * only move elements within that node (at most ChunkSize of them), so
+     * take constant time. Inserting into a full node splits it in two, and
+     * erasing from a node less than half full merges it with a neighbour if
+     * they both fit in one node. A node can have room both before and after
+     * its elements, and nodes made by pushing at one end are filled towards
+     * the other, so pushing at either end hardly ever moves any elements.
+     * @note Iterators are bidirectional. Inserting or erasing invalidates
+     * iterators and references to the elements in the nodes it changes, which
+     * are the one at the position and those either side of it.
+     * @note Elements are moved between slots to open and close gaps, one at
+     * a time, so T's move constructor must not throw, as there'd be no way to
+     * put back the ones already moved. Copying them can throw, as new
+     * elements are constructed before anything is moved.
+     * @tparam T the type of elements to store
+     * @tparam ChunkSize how many elements each node can hold
+     * @tparam Allocator rebound to allocate the nodes
+     */
+    template <
+        typename T,
+        std::size_t ChunkSize = detail::default_unrolled_chunk_size<T>,
+        class Allocator = std::allocator<T>
+    >
+    requires (
+        ChunkSize > 1 // so that a full node can be split
+        and std::is_nothrow_move_constructible_v<T>
+    )
+    class unrolled_list {
+    private:
+        using Node = detail::unrolled_node<T, ChunkSize>;
+        using Links = detail::unrolled_links;
+        using NodeAllocator = std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+        using NodeTraits = std::allocator_traits<NodeAllocator>;
+    public:
+        using value_type = T;
+        using allocator_type = Allocator;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using reference = T&;
+        using const_reference = const T&;
+        using pointer = T*;
+        using const_pointer = const T*;
+        using iterator = detail::unrolled_iterator<T, ChunkSize, false>;
+        using const_iterator = detail::unrolled_iterator<T, ChunkSize, true>;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+        static constexpr size_type chunk_size = ChunkSize;
+        // member functions
+        constexpr unrolled_list() noexcept(noexcept(NodeAllocator())) {}
+        constexpr explicit unrolled_list(const Allocator& alloc) noexcept : _allocator(alloc) {}
+        constexpr unrolled_list(size_type count, const T& value, const Allocator& alloc = Allocator())
+          : unrolled_list(alloc) // delegated, so the destructor cleans up if this throws
+          {
+            resize(count, value);
+        }
+        constexpr explicit unrolled_list(size_type count, const Allocator& alloc = Allocator())
+          : unrolled_list(alloc)
+          {
+            resize(count);
+        }
+        template<std::input_iterator InputIt>
+        constexpr unrolled_list(InputIt first, InputIt last, const Allocator& alloc = Allocator())
+          : unrolled_list(alloc)
+          {
+            _append(first, last);
+        }
+        constexpr unrolled_list(const unrolled_list& other)
+          : unrolled_list(other, NodeTraits::select_on_container_copy_construction(other._allocator))
+          {}
+        constexpr unrolled_list(const unrolled_list& other, const Allocator& alloc)
+          : unrolled_list(alloc)
+          {
+            _append(other.begin(), other.end());
+        }
+        constexpr unrolled_list(unrolled_list&& other) noexcept
+          : _allocator(std::move(other._allocator))
+          {
+            _take_nodes(other);
+        }
+        constexpr unrolled_list(unrolled_list&& other, const Allocator& alloc)
+          : unrolled_list(alloc)
+          {
+            if (_allocator == other._allocator) {
+                _take_nodes(other);
+                return;
+            }
+            // other's nodes can't be freed with our allocator, so its elements are moved individually
+            for (T& element : other) {
+                emplace_back(std::move(element));
+            }
+        }
+        constexpr unrolled_list(std::initializer_list<T> init, const Allocator& alloc = Allocator())
+          : unrolled_list(init.begin(), init.end(), alloc)
+          {}
+        constexpr ~unrolled_list() {
+            clear();
+        }
+        constexpr unrolled_list& operator=(const unrolled_list& other) {
+            if (this == &other) { return *this; }
+            // our nodes go first, using the allocator they came from
+            clear();
+            if constexpr (NodeTraits::propagate_on_container_copy_assignment::value) {
+                _allocator = other._allocator;
+            }
+            _append(other.begin(), other.end());
+            return *this;
+        }
+        constexpr unrolled_list& operator=(unrolled_list&& other) noexcept(
+            NodeTraits::propagate_on_container_move_assignment::value or
+            NodeTraits::is_always_equal::value
+        ) {
+            if (this == &other) { return *this; }
+            clear();
+            if constexpr (NodeTraits::propagate_on_container_move_assignment::value) {
+                _allocator = other._allocator;
+            } else if (_allocator != other._allocator) {
+                // we can't take ownership of other's nodes, so must move each element individually
+                for (T& element : other) {
+                    emplace_back(std::move(element));
+                }
+                return *this;
+            }
+            _take_nodes(other);
+            return *this;
+        }
+        constexpr unrolled_list& operator=(std::initializer_list<T> ilist) {
+            assign(ilist);
+            return *this;
+        }
+        constexpr void assign(size_type count, const T& value) {
+            clear();
+            resize(count, value);
+        }
+        template<std::input_iterator InputIt>
+        constexpr void assign(InputIt first, InputIt last) {
+            clear();
+            _append(first, last);
+        }
+        constexpr void assign(std::initializer_list<T> ilist) {
+            assign(ilist.begin(), ilist.end());
+        }
+        constexpr allocator_type get_allocator() const noexcept { return allocator_type(_allocator); }
+        // element access
+        constexpr reference front() { return *_front_node()->at(0); }
+        constexpr const_reference front() const { return *_front_node()->at(0); }
+        constexpr reference back() { return *_back_node()->at(_back_node()->count - 1); }
+        constexpr const_reference back() const { return *_back_node()->at(_back_node()->count - 1); }
+        // iterators
+        constexpr iterator begin() noexcept { return {_end.next, 0}; }
+        constexpr const_iterator begin() const noexcept { return {_end.next, 0}; }
+        constexpr const_iterator cbegin() const noexcept { return begin(); }
+        constexpr iterator end() noexcept { return {&_end, 0}; }
+        // the node past the end has no elements, so a const_iterator to it can't be used to modify any
+        constexpr const_iterator end() const noexcept { return {const_cast<Links*>(&_end), 0}; }
+        constexpr const_iterator cend() const noexcept { return end(); }
+        constexpr reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+        constexpr const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+        constexpr const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+        constexpr reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+        constexpr const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+        constexpr const_reverse_iterator crend() const noexcept { return rend(); }
+        // capacity
+        [[nodiscard]] constexpr bool empty() const noexcept { return _size == 0; }
+        constexpr size_type size() const noexcept { return _size; }
+        constexpr size_type max_size() const noexcept {
+            return std::numeric_limits<difference_type>::max();
+        }
+        // modifiers
+        constexpr void clear() noexcept {
+            Links* links = _end.next;
+            while (links != &_end) {
+                Node* node = static_cast<Node*>(links);
+                links = links->next;
+                for (size_type i = 0; i < node->count; i++) {
+                    std::destroy_at(node->at(i));
+                }
+                _delete_node(node);
+            }
+            _end.next = &_end;
+            _end.prev = &_end;
+            _size = 0;
+        }
+        constexpr iterator insert(const_iterator pos, const T& value) {
+            return emplace(pos, value);
+        }
+        constexpr iterator insert(const_iterator pos, T&& value) {
+            return emplace(pos, std::move(value));
+        }
+        template<class... Args>
+        constexpr iterator emplace(const_iterator pos, Args&&... args) {
+            // constructed before making room, as that moves elements, which args might refer to
+            T value(std::forward<Args>(args)...);
+            auto [node, index] = _make_room(pos.node(), pos.index());
+            try {
+                std::construct_at(node->at(index), std::move(value));
+            } catch (...) {
+                _close_gap(node, index);
+                throw;
+            }
+            _size++;
+            return {node, index};
+        }
+        constexpr iterator erase(const_iterator pos) {
+            Node* node = static_cast<Node*>(pos.node());
+            size_type index = pos.index();
+            Links* next = node->next;
+            std::destroy_at(node->at(index));
+            _size--;
+            if (_close_gap(node, index)) {
+                return {next, 0};
+            }
+            // a node less than half full is merged with a neighbour, if they both fit in one node
+            if (node->count < ChunkSize / 2) {
+                if (next != &_end and node->count + static_cast<Node*>(next)->count <= ChunkSize) {
+                    _merge_next(node);
+                } else if (
+                    node->prev != &_end and static_cast<Node*>(node->prev)->count + node->count <= ChunkSize
+                ) {
+                    Node* prev = static_cast<Node*>(node->prev);
+                    index += prev->count;
+                    _merge_next(prev);
+                    node = prev;
+                }
+            }
+            if (index == node->count) {
+                return {node->next, 0};
+            }
+            return {node, index};
+        }
+        constexpr iterator erase(const_iterator first, const_iterator last) {
+            // erasing can merge nodes, which would invalidate last, so count how many to erase instead
+            auto count = std::distance(first, last);
+            iterator pos(first.node(), first.index());
+            for (; count > 0; count--) {
+                pos = erase(pos);
+            }
+            return pos;
+        }
+        constexpr void push_back(const T& value) {
+            emplace_back(value);
+        }
+        constexpr void push_back(T&& value) {
+            emplace_back(std::move(value));
+        }
+        template<class... Args>
+        constexpr reference emplace_back(Args&&... args) {
+            return *emplace(end(), std::forward<Args>(args)...);
+        }
+        constexpr void pop_back() {
+            Node* node = _back_node();
+            std::destroy_at(node->at(node->count - 1));
+            _size--;
+            if (--node->count == 0) {
+                _unlink_node(node);
+            }
+        }
+        constexpr void push_front(const T& value) {
+            emplace_front(value);
+        }
+        constexpr void push_front(T&& value) {
+            emplace_front(std::move(value));
+        }
+        template<class... Args>
+        constexpr reference emplace_front(Args&&... args) {
+            return *emplace(begin(), std::forward<Args>(args)...);
+        }
+        constexpr void pop_front() {
+            Node* node = _front_node();
+            std::destroy_at(node->at(0));
+            _size--;
+            node->first++;
+            if (--node->count == 0) {
+                _unlink_node(node);
+            }
+        }
+        constexpr void resize(size_type count) {
+            while (_size > count) {
+                pop_back();
+            }
+            while (_size < count) {
+                emplace_back();
+            }
+        }
+        constexpr void resize(size_type count, const value_type& value) {
+            while (_size > count) {
+                pop_back();
+            }
+            while (_size < count) {
+                emplace_back(value);
+            }
+        }
+        constexpr void swap(unrolled_list& other) noexcept {
+            if constexpr (NodeTraits::propagate_on_container_swap::value) {
+                std::swap(_allocator, other._allocator);
+            }
+            Links* first = _end.next;
+            Links* last = _end.prev;
+            size_type size = _size;
+            _link_ends(other._end.next, other._end.prev, other._size);
+            other._link_ends(first, last, size);
+        }
+        // comparison
+        constexpr bool operator==(const unrolled_list& other) const {
+            return _size == other._size and std::equal(begin(), end(), other.begin());
+        }
+        constexpr auto operator<=>(const unrolled_list& other) const
+        requires std::three_way_comparable<T> {
+            return std::lexicographical_compare_three_way(
+                begin(), end(), other.begin(), other.end()
+            );
+        }
+    private:
+        constexpr Node* _front_node() const { return static_cast<Node*>(_end.next); }
+        constexpr Node* _back_node() const { return static_cast<Node*>(_end.prev); }
+
+        template<std::input_iterator InputIt>
+        constexpr void _append(InputIt first, InputIt last) {
+            for (; first != last; ++first) {
+                emplace_back(*first);
+            }
+        }
+        // makes the chain of nodes from first to last ours, or none if the list is empty
+        constexpr void _link_ends(Links* first, Links* last, size_type size) noexcept {
+            if (size == 0) {
+                _end.next = &_end;
+                _end.prev = &_end;
+            } else {
+                _end.next = first;
+                _end.prev = last;
+                first->prev = &_end;
+                last->next = &_end;
+            }
+            _size = size;
+        }
+        constexpr void _take_nodes(unrolled_list& other) noexcept {
+            _link_ends(other._end.next, other._end.prev, other._size);
+            other._link_ends(nullptr, nullptr, 0);
+        }
+        // allocates an empty node and links it in before next
+        constexpr Node* _new_node_before(Links* next, size_type first) {
+            Node* node = NodeTraits::allocate(_allocator, 1);
+            NodeTraits::construct(_allocator, node);
+            node->first = first;
+            node->next = next;
+            node->prev = next->prev;
+            next->prev->next = node;
+            next->prev = node;
+            return node;
+        }
+        constexpr void _delete_node(Node* node) noexcept {
+            NodeTraits::destroy(_allocator, node);
+            NodeTraits::deallocate(_allocator, node, 1);
+        }
+        // unlinks and deletes a node which holds no elements
+        constexpr void _unlink_node(Node* node) noexcept {
+            node->prev->next = node->next;
+            node->next->prev = node->prev;
+            _delete_node(node);
+        }
+        // moves the element from one slot to another, which may be in a different node
+        static constexpr void _relocate(Node* from, size_type from_slot, Node* to, size_type to_slot) noexcept {
+            std::construct_at(&to->slots[to_slot].value, std::move(from->slots[from_slot].value));
+            std::destroy_at(&from->slots[from_slot].value);
+        }
+        /*
+         * makes room for an element at index in node, which is unconstructed
+         * afterwards, moving whichever side of it has fewer elements and room
+         * to move into
+         */
+        static constexpr std::pair<Node*, size_type> _open_gap(Node* node, size_type index) {
+            bool room_before = node->first > 0;
+            bool room_after = node->first + node->count < ChunkSize;
+            if (room_before and (index <= node->count - index or not room_after)) {
+                for (size_type i = 0; i < index; i++) {
+                    _relocate(node, node->first + i, node, node->first + i - 1);
+                }
+                node->first--;
+            } else {
+                for (size_type i = node->count; i > index; i--) {
+                    _relocate(node, node->first + i - 1, node, node->first + i);
+                }
+            }
+            node->count++;
+            return {node, index};
+        }
+        // undoes _open_gap(), and deletes the node if that leaves it empty, returning whether it did
+        constexpr bool _close_gap(Node* node, size_type index) noexcept {
+            if (index < node->count - 1 - index) {
+                for (size_type i = index; i > 0; i--) {
+                    _relocate(node, node->first + i - 1, node, node->first + i);
+                }
+                node->first++;
+            } else {
+                for (size_type i = index + 1; i < node->count; i++) {
+                    _relocate(node, node->first + i, node, node->first + i - 1);
+                }
+            }
+            if (--node->count == 0) {
+                _unlink_node(node);
+                return true;
+            }
+            return false;
+        }
+        // makes room for an element before the one at index in the node at links
+        constexpr std::pair<Node*, size_type> _make_room(Links* links, size_type index) {
+            if (links == &_end) {
+                if (_size != 0 and _back_node()->count < ChunkSize) {
+                    return _open_gap(_back_node(), _back_node()->count);
+                }
+                return _open_gap(_new_node_before(&_end, 0), 0);
+            }
+            Node* node = static_cast<Node*>(links);
+            if (node->count < ChunkSize) {
+                return _open_gap(node, index);
+            }
+            if (index == 0) {
+                // the element can go at the end of the previous node instead, if there's room
+                if (node->prev != &_end and static_cast<Node*>(node->prev)->count < ChunkSize) {
+                    Node* prev = static_cast<Node*>(node->prev);
+                    return _open_gap(prev, prev->count);
+                }
+                // a new node is filled from the back, so that pushing more in front of it doesn't move any
+                return _open_gap(_new_node_before(node, ChunkSize), 0);
+            }
+            // the back half of a full node is moved into a new one
+            Node* back = _new_node_before(node->next, 0);
+            size_type half = ChunkSize / 2;
+            for (size_type i = half; i < ChunkSize; i++) {
+                _relocate(node, node->first + i, back, i - half);
+            }
+            back->count = ChunkSize - half;
+            node->count = half;
+            if (index > half) {
+                return _open_gap(back, index - half);
+            }
+            return _open_gap(node, index);
+        }
+        // moves all elements of the node after node into it and deletes that one
+        constexpr void _merge_next(Node* node) noexcept {
+            Node* next = static_cast<Node*>(node->next);
+            if (node->first + node->count + next->count > ChunkSize) {
+                for (size_type i = 0; i < node->count; i++) {
+                    _relocate(node, node->first + i, node, i);
+                }
+                node->first = 0;
+            }
+            for (size_type i = 0; i < next->count; i++) {
+                _relocate(next, next->first + i, node, node->first + node->count + i);
+            }
+            node->count += next->count;
+            next->count = 0;
+            _unlink_node(next);
+        }
+
+        [[no_unique_address]] NodeAllocator _allocator;
+        // the node past the end, which links to the first and last nodes, or to itself when empty
+        Links _end{&_end, &_end};
+        size_type _size = 0;
+    };
+}
+
+#endif
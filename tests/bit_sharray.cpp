@@ -0,0 +1,239 @@
+#include <cstddef>
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include <codlili/bit_sharray.hpp>
+
+
+using namespace com::saxbophone::codlili;
+
+namespace {
+    // a pattern of bits which isn't periodic in the word size
+    bool pattern(std::size_t i) {
+        return i % 3 == 0 or i % 7 == 0;
+    }
+
+    // pushes count bits of the pattern, alternating between the back and the front
+    void push_both_ends(bit_sharray<>& bits, std::vector<bool>& expected, std::size_t count) {
+        for (std::size_t i = 0; i < count; i++) {
+            if (i % 2 == 0) {
+                bits.push_back(pattern(i));
+                expected.push_back(pattern(i));
+            } else {
+                bits.push_front(pattern(i));
+                expected.insert(expected.begin(), pattern(i));
+            }
+        }
+    }
+
+    constexpr std::size_t count_of_pushes(std::size_t count) {
+        bit_sharray<> bits;
+        for (std::size_t i = 0; i < count; i++) {
+            bits.push_front(i % 2 == 0);
+            bits.push_back(i % 3 == 0);
+        }
+        return bits.count();
+    }
+}
+
+static_assert(count_of_pushes(100) == 84);
+
+TEST_CASE("bit_sharray mirrors the API of sharray") {
+    SECTION("construction") {
+        CHECK(bit_sharray<>().empty());
+        CHECK(bit_sharray<>(100, true).size() == 100);
+        CHECK(bit_sharray<>(100, true).count() == 100);
+        CHECK(bit_sharray<>(100).count() == 0);
+        bit_sharray<> bits = {true, false, true};
+        CHECK(bits.size() == 3);
+        CHECK(bits[0]);
+        CHECK(not bits[1]);
+        CHECK(bits[2]);
+        std::vector<bool> values = {false, true};
+        CHECK(bit_sharray<>(values.begin(), values.end()) == bit_sharray<>{false, true});
+    }
+
+    SECTION("element access") {
+        bit_sharray<> bits(130);
+        bits[0] = true;
+        bits[129] = true;
+        bits.at(64) = bits[0];
+        CHECK(bits.front());
+        CHECK(bits.back());
+        CHECK(bits.at(64));
+        CHECK(bits.count() == 3);
+        CHECK_THROWS_AS(bits.at(130), std::out_of_range);
+        const bit_sharray<>& view = bits;
+        CHECK_THROWS_AS(view.at(130), std::out_of_range);
+        bits.flip(0);
+        CHECK(not bits.front());
+    }
+
+    SECTION("copying and moving") {
+        bit_sharray<> bits(100, true);
+        bit_sharray<> copy = bits;
+        CHECK(copy == bits);
+        bit_sharray<> moved = std::move(bits);
+        CHECK(moved == copy);
+        CHECK(bits.empty());
+        bits.push_back(true);
+        CHECK(bits.count() == 1);
+        bits = std::move(moved);
+        CHECK(bits == copy);
+    }
+
+    SECTION("iterators") {
+        bit_sharray<> bits = {true, false, false, true};
+        CHECK(std::count(bits.begin(), bits.end(), true) == 2);
+        CHECK(std::vector<bool>(bits.rbegin(), bits.rend()) == std::vector<bool>{true, false, false, true});
+        for (auto bit : bits) {
+            bit = not bit;
+        }
+        CHECK(bits == bit_sharray<>{false, true, true, false});
+        CHECK(bits.end() - bits.begin() == 4);
+    }
+
+    SECTION("comparison") {
+        CHECK(bit_sharray<>{false, true} < bit_sharray<>{true});
+        CHECK(bit_sharray<>{true} < bit_sharray<>{true, false});
+        CHECK(bit_sharray<>(100, true) != bit_sharray<>(101, true));
+    }
+}
+
+TEST_CASE("bit_sharray packs bits into words") {
+    bit_sharray<> bits;
+    for (int i = 0; i < 1000; i++) {
+        bits.push_back(true);
+    }
+
+    CHECK(bits.capacity() >= 1000);
+    // 1000 bools would take up 1000 bytes, but even with room to grow the bits take far fewer
+    CHECK(bits.capacity() / 8 < 1000 / 2);
+}
+
+TEST_CASE("bit_sharray grows and shrinks at both ends") {
+    bit_sharray<> bits;
+    std::vector<bool> expected;
+    std::size_t count = (std::size_t)GENERATE(1, 63, 64, 65, 200, 1000);
+    push_both_ends(bits, expected, count);
+
+    REQUIRE(std::vector<bool>(bits.begin(), bits.end()) == expected);
+
+    SECTION("pushing at the front doesn't reallocate while there's room") {
+        bits.reserve({10000, 0});
+        auto capacity = bits.capacity();
+        for (int i = 0; i < 9000; i++) {
+            bits.push_front(i % 2 == 0);
+        }
+        CHECK(bits.capacity() == capacity);
+    }
+
+    SECTION("popping") {
+        while (not bits.empty()) {
+            if (bits.size() % 2 == 0) {
+                REQUIRE(bits.front() == expected.front());
+                bits.pop_front();
+                expected.erase(expected.begin());
+            } else {
+                REQUIRE(bits.back() == expected.back());
+                bits.pop_back();
+                expected.pop_back();
+            }
+            REQUIRE(bits.count() == (std::size_t)std::count(expected.begin(), expected.end(), true));
+        }
+    }
+
+    SECTION("resizing") {
+        std::size_t new_size = (std::size_t)GENERATE(0, 1, 64, 100, 300);
+        bool value = GENERATE(false, true);
+        bits.resize(new_size, value);
+        expected.resize(new_size, value);
+        CHECK(std::vector<bool>(bits.begin(), bits.end()) == expected);
+        CHECK(bits.count() == (std::size_t)std::count(expected.begin(), expected.end(), true));
+    }
+
+    SECTION("clearing") {
+        bits.clear();
+        CHECK(bits.empty());
+        CHECK(bits.count() == 0);
+        CHECK(bits.find_first() == 0);
+    }
+}
+
+TEST_CASE("bit_sharray counts and searches whole words at a time") {
+    bit_sharray<> bits;
+    std::vector<bool> expected;
+    std::size_t count = (std::size_t)GENERATE(1, 64, 65, 500);
+    push_both_ends(bits, expected, count);
+
+    SECTION("count") {
+        std::size_t set = (std::size_t)std::count(expected.begin(), expected.end(), true);
+        CHECK(bits.count() == set);
+        CHECK(bits.count(true) == set);
+        CHECK(bits.count(false) == count - set);
+    }
+
+    SECTION("find_first() and find_next() visit every bit set") {
+        std::vector<std::size_t> found;
+        for (std::size_t i = bits.find_first(); i != bits.size(); i = bits.find_next(i)) {
+            found.push_back(i);
+        }
+        std::vector<std::size_t> set;
+        for (std::size_t i = 0; i < expected.size(); i++) {
+            if (expected[i]) {
+                set.push_back(i);
+            }
+        }
+        CHECK(found == set);
+    }
+
+    SECTION("find") {
+        CHECK(bits.find(true) - bits.begin() == std::find(expected.begin(), expected.end(), true) - expected.begin());
+        CHECK(bits.find(false) - bits.begin() == std::find(expected.begin(), expected.end(), false) - expected.begin());
+        bit_sharray<> all_set(200, true);
+        CHECK(all_set.find(false) == all_set.end());
+        CHECK(not bit_sharray<>(200, false).contains(true));
+        CHECK(bit_sharray<>(200, false).contains(false));
+    }
+}
+
+TEST_CASE("bit_sharray bitwise operators combine bits at the same index") {
+    std::size_t count = (std::size_t)GENERATE(1, 64, 130, 500);
+    // build the operands from opposite ends, so that their bits are laid out differently within words
+    bit_sharray<> lhs;
+    bit_sharray<> rhs;
+    std::vector<bool> left(count);
+    std::vector<bool> right(count);
+    for (std::size_t i = 0; i < count; i++) {
+        left[i] = i % 3 == 0;
+        right[count - 1 - i] = (count - 1 - i) % 5 == 0;
+        lhs.push_back(left[i]);
+        rhs.push_front(right[count - 1 - i]);
+    }
+    std::vector<bool> expected(count);
+
+    SECTION("and") {
+        lhs &= rhs;
+        std::transform(left.begin(), left.end(), right.begin(), expected.begin(), [](bool a, bool b) { return a and b; });
+    }
+    SECTION("or") {
+        lhs = lhs | rhs;
+        std::transform(left.begin(), left.end(), right.begin(), expected.begin(), [](bool a, bool b) { return a or b; });
+    }
+    SECTION("xor") {
+        lhs ^= rhs;
+        std::transform(left.begin(), left.end(), right.begin(), expected.begin(), [](bool a, bool b) { return a != b; });
+    }
+    SECTION("not") {
+        lhs = ~lhs;
+        std::transform(left.begin(), left.end(), expected.begin(), [](bool a) { return not a; });
+    }
+
+    CHECK(std::vector<bool>(lhs.begin(), lhs.end()) == expected);
+    CHECK(lhs.count() == (std::size_t)std::count(expected.begin(), expected.end(), true));
+    CHECK_THROWS_AS(lhs &= bit_sharray<>(count + 1), std::invalid_argument);
+}
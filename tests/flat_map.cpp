@@ -0,0 +1,93 @@
+#include <cstddef>
+
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include <codlili/flat_map.hpp>
+
+
+using namespace com::saxbophone::codlili;
+
+TEST_CASE("flat_map keeps its elements sorted by key") {
+    SECTION("construction") {
+        CHECK(flat_map<int, std::string>().empty());
+        flat_map<int, std::string> map = {{3, "three"}, {1, "one"}, {3, "drei"}};
+        REQUIRE(map.size() == 2);
+        CHECK(map.begin()->first == 1);
+        // the first of any equivalent elements is kept
+        CHECK(map.at(3) == "three");
+        CHECK(flat_map<int, int>(sorted_unique, {{1, 1}, {2, 4}}).at(2) == 4);
+    }
+
+    SECTION("element access") {
+        flat_map<std::string, int> map;
+        map["b"] = 2;
+        map["a"] = 1;
+        map["b"]++;
+        CHECK(map.at("a") == 1);
+        CHECK(map.at("b") == 3);
+        CHECK(map["c"] == 0);
+        CHECK(map.size() == 3);
+        CHECK_THROWS_AS(map.at("d"), std::out_of_range);
+        const auto& view = map;
+        CHECK(view.at("b") == 3);
+        CHECK_THROWS_AS(view.at("d"), std::out_of_range);
+    }
+
+    SECTION("modifiers") {
+        flat_map<int, std::string> map;
+        CHECK(map.try_emplace(2, 3, 'x').second);
+        CHECK(map.at(2) == "xxx");
+        CHECK(not map.try_emplace(2, "y").second);
+        CHECK(map.at(2) == "xxx");
+        CHECK(map.insert_or_assign(2, "y").second == false);
+        CHECK(map.at(2) == "y");
+        CHECK(map.insert_or_assign(1, "z").second);
+        CHECK(map.emplace(0, "w").second);
+        CHECK(not map.insert({0, "v"}).second);
+        std::vector<std::pair<int, std::string>> more = {{5, "five"}, {1, "uno"}, {4, "four"}};
+        map.insert(more.begin(), more.end());
+        CHECK(map.size() == 5);
+        CHECK(map.at(1) == "z");
+        CHECK(map.erase(4) == 1);
+        auto after = map.erase(map.find(5));
+        CHECK(after == map.end());
+        CHECK(map == flat_map<int, std::string>{{0, "w"}, {1, "z"}, {2, "y"}});
+    }
+
+    SECTION("values can be changed through iterators") {
+        flat_map<int, int> map = {{1, 1}, {2, 2}};
+        for (auto& [key, value] : map) {
+            value *= 10;
+        }
+        CHECK(map.find(2)->second == 20);
+        CHECK(map.value_comp()({1, 5}, {2, 0}));
+    }
+}
+
+TEST_CASE("flat_map behaves like std::map") {
+    flat_map<int, int> flat;
+    std::map<int, int> reference;
+    int value = 3;
+    for (int i = 0; i < 2000; i++) {
+        value = (value * 1103 + 12345) % 1000;
+        switch (i % 4) {
+        case 0:
+            CHECK(flat.erase(value) == reference.erase(value));
+            break;
+        case 1:
+            flat[value] += i;
+            reference[value] += i;
+            break;
+        default:
+            CHECK(flat.insert({value, i}).second == reference.insert({value, i}).second);
+        }
+    }
+
+    CHECK(std::vector<std::pair<int, int>>(flat.begin(), flat.end()) == std::vector<std::pair<int, int>>(reference.begin(), reference.end()));
+}
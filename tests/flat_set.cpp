@@ -0,0 +1,138 @@
+#include <cstddef>
+
+#include <functional>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include <codlili/flat_set.hpp>
+
+
+using namespace com::saxbophone::codlili;
+
+namespace {
+    constexpr int sum_of_unique(std::initializer_list<int> values) {
+        flat_set<int> set(values);
+        int sum = 0;
+        for (int value : set) {
+            sum += value;
+        }
+        return sum;
+    }
+}
+
+static_assert(sum_of_unique({3, 1, 3, 2}) == 6);
+
+TEST_CASE("flat_set keeps its keys sorted and unique") {
+    SECTION("construction") {
+        CHECK(flat_set<int>().empty());
+        flat_set<int> set = {5, 3, 5, 1, 3};
+        CHECK(std::vector<int>(set.begin(), set.end()) == std::vector<int>{1, 3, 5});
+        CHECK(flat_set<int>(sharray<int>{2, 2, 1}) == flat_set<int>{1, 2});
+        CHECK(flat_set<int>(sorted_unique, {1, 2, 3}).size() == 3);
+        flat_set<int, std::greater<int>> descending = {1, 3, 2};
+        CHECK(std::vector<int>(descending.begin(), descending.end()) == std::vector<int>{3, 2, 1});
+    }
+
+    SECTION("inserting single keys") {
+        flat_set<int> set;
+        auto [position, inserted] = set.insert(5);
+        CHECK(inserted);
+        CHECK(*position == 5);
+        CHECK(set.insert(3).second);
+        CHECK(set.emplace(7).second);
+        CHECK(not set.insert(5).second);
+        CHECK(*set.insert(5).first == 5);
+        CHECK(std::vector<int>(set.begin(), set.end()) == std::vector<int>{3, 5, 7});
+    }
+
+    SECTION("inserting with a hint") {
+        flat_set<int> set = {10, 20};
+        // right and wrong hints give the same result
+        CHECK(*set.insert(set.find(20), 15) == 15);
+        CHECK(*set.insert(set.begin(), 30) == 30);
+        CHECK(*set.emplace_hint(set.end(), 20) == 20);
+        CHECK(std::vector<int>(set.begin(), set.end()) == std::vector<int>{10, 15, 20, 30});
+    }
+
+    SECTION("inserting ranges") {
+        flat_set<int> set = {2, 4, 6};
+        std::vector<int> unsorted = {5, 4, 1, 9, 1};
+        set.insert(unsorted.begin(), unsorted.end());
+        CHECK(std::vector<int>(set.begin(), set.end()) == std::vector<int>{1, 2, 4, 5, 6, 9});
+        std::vector<int> sorted = {0, 3, 10};
+        set.insert(sorted_unique, sorted.begin(), sorted.end());
+        CHECK(std::vector<int>(set.begin(), set.end()) == std::vector<int>{0, 1, 2, 3, 4, 5, 6, 9, 10});
+        set.insert(sorted_unique, {11, 12});
+        CHECK(set.size() == 11);
+    }
+
+    SECTION("erasing") {
+        flat_set<int> set = {1, 2, 3, 4, 5};
+        CHECK(set.erase(3) == 1);
+        CHECK(set.erase(3) == 0);
+        CHECK(*set.erase(set.begin()) == 2);
+        set.erase(set.begin(), set.begin() + 2);
+        CHECK(set == flat_set<int>{5});
+        set.clear();
+        CHECK(set.empty());
+    }
+
+    SECTION("extracting and replacing") {
+        flat_set<int> set = {3, 1, 2};
+        sharray<int> keys = std::move(set).extract();
+        CHECK(keys == sharray<int>{1, 2, 3});
+        CHECK(set.empty());
+        set.replace(std::move(keys));
+        CHECK(set.size() == 3);
+    }
+}
+
+TEST_CASE("flat_set lookup") {
+    flat_set<int> set = {10, 20, 30, 40};
+
+    CHECK(*set.find(20) == 20);
+    CHECK(set.find(25) == set.end());
+    CHECK(set.contains(40));
+    CHECK(not set.contains(5));
+    CHECK(set.count(10) == 1);
+    CHECK(set.count(15) == 0);
+    CHECK(*set.lower_bound(20) == 20);
+    CHECK(*set.lower_bound(21) == 30);
+    CHECK(*set.upper_bound(20) == 30);
+    CHECK(set.upper_bound(40) == set.end());
+    auto [first, last] = set.equal_range(30);
+    CHECK(last - first == 1);
+    CHECK(set.equal_range(35).first == set.equal_range(35).second);
+
+    SECTION("with transparent comparison") {
+        flat_set<std::string, std::less<>> names = {"bob", "alice", "carol"};
+        CHECK(names.contains("alice"));
+        CHECK(*names.find("carol") == "carol");
+        CHECK(names.erase("bob") == 1);
+        CHECK(names.size() == 2);
+    }
+}
+
+TEST_CASE("flat_set behaves like std::set") {
+    flat_set<int> flat;
+    std::set<int> reference;
+    int value = 7;
+    for (int i = 0; i < 2000; i++) {
+        value = (value * 1103 + 12345) % 1000;
+        if (i % 3 == 2) {
+            CHECK(flat.erase(value) == reference.erase(value));
+        } else {
+            CHECK(flat.insert(value).second == reference.insert(value).second);
+        }
+    }
+
+    CHECK(std::vector<int>(flat.begin(), flat.end()) == std::vector<int>(reference.begin(), reference.end()));
+    for (int key = 0; key < 1000; key++) {
+        REQUIRE(flat.contains(key) == reference.contains(key));
+        REQUIRE(flat.lower_bound(key) - flat.begin() == std::distance(reference.begin(), reference.lower_bound(key)));
+        REQUIRE(flat.upper_bound(key) - flat.begin() == std::distance(reference.begin(), reference.upper_bound(key)));
+    }
+}
@@ -0,0 +1,375 @@
+#include <cstddef>
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include <codlili/list.hpp>
+
+#include "helpers.hpp"
+
+
+using namespace com::saxbophone::codlili;
+
+namespace {
+    // checking size() after every push would be quadratic if it counted the elements
+    constexpr std::size_t size_after_pushes(std::size_t count) {
+        list<int> elements;
+        while (elements.size() < count) {
+            elements.push_back((int)elements.size());
+        }
+        return elements.size();
+    }
+
+    template <typename T, class Allocator>
+    std::vector<T> contents(const list<T, Allocator>& elements) {
+        return {elements.begin(), elements.end()};
+    }
+
+    template <class List, typename T>
+    List from(const std::vector<T>& values) {
+        List elements;
+        for (const T& value : values) {
+            elements.push_back(value);
+        }
+        return elements;
+    }
+
+    // a pseudo-random sequence with plenty of repeated values
+    std::vector<int> scrambled(std::size_t count) {
+        std::vector<int> values;
+        unsigned state = 12345;
+        for (std::size_t i = 0; i < count; i++) {
+            state = state * 1103515245 + 12345;
+            values.push_back((int)((state >> 16) % 100));
+        }
+        return values;
+    }
+
+    // has no default constructor, and counts how many times it's been copied
+    struct Copies {
+        static inline std::size_t count = 0;
+
+        explicit Copies(int value) : value(value) {}
+        Copies(const Copies& other) : value(other.value) { count++; }
+        Copies(Copies&& other) noexcept = default;
+
+        int value;
+    };
+
+    constexpr list<int> make_list(int count) {
+        list<int> elements;
+        for (int i = 0; i < count; i++) {
+            elements.emplace_back(i);
+        }
+        return elements;
+    }
+
+    constexpr int moved_and_swapped(int count) {
+        list<int> elements = make_list(count);
+        list<int> other;
+        other = std::move(elements);
+        elements.emplace_front(100);
+        elements.swap(other);
+        return elements.back() + other.front() + (int)elements.size();
+    }
+
+    constexpr int sorted_and_merged(int count) {
+        list<int> odd;
+        list<int> even;
+        for (int i = 0; i < count; i++) {
+            (i % 2 == 0 ? even : odd).push_back((i * 7) % count);
+        }
+        odd.sort();
+        even.sort();
+        odd.merge(even);
+        odd.reverse();
+        odd.unique();
+        odd.remove_if([](int element) { return element % 3 == 0; });
+        // weighted by position, so that the order matters
+        int sum = 0;
+        int position = 0;
+        for (int element : odd) {
+            sum += element * position++;
+        }
+        return sum;
+    }
+}
+
+TEST_CASE("list keeps count of its elements") {
+    list<int> elements;
+    CHECK(elements.size() == 0);
+
+    SECTION("pushing and popping") {
+        elements.push_back(2);
+        elements.push_front(1);
+        elements.push_back(3, 9);
+        elements.push_front(2, 0);
+        CHECK(elements.size() == 7);
+        elements.pop_front();
+        elements.pop_back();
+        CHECK(elements.size() == 5);
+        CHECK(std::vector<int>(elements.begin(), elements.end()) == std::vector<int>{0, 1, 2, 9, 9});
+    }
+
+    SECTION("construction, copying and clearing") {
+        CHECK(list<int>(5).size() == 5);
+        CHECK(list<int>(3, 7).size() == 3);
+        list<int> copy = {1, 2, 3};
+        CHECK(copy.size() == 3);
+        elements = copy;
+        CHECK(elements.size() == 3);
+        elements.clear();
+        CHECK(elements.size() == 0);
+        CHECK(elements.empty());
+    }
+
+    SECTION("resizing") {
+        elements.resize(4, 1);
+        CHECK(elements.size() == 4);
+        elements.resize(2);
+        CHECK(elements.size() == 2);
+        elements.resize(0);
+        CHECK(elements.empty());
+    }
+
+    SECTION("swapping") {
+        list<int> other = {1, 2, 3};
+        elements.swap(other);
+        CHECK(elements.size() == 3);
+        CHECK(other.size() == 0);
+    }
+
+    SECTION("comparison") {
+        CHECK(list<int>{1, 2} == list<int>{1, 2});
+        CHECK(list<int>{1, 2} != list<int>{1, 2, 3});
+        CHECK(list<int>{1, 3} != list<int>{1, 2});
+    }
+}
+
+TEST_CASE("list size() is cheap enough for constant expressions") {
+    STATIC_REQUIRE(size_after_pushes(1000) == 1000);
+}
+
+TEST_CASE("list operations relink nodes without allocating") {
+    using counted_list = list<int, CountingAllocator<int>>;
+
+    SECTION("splicing a whole list") {
+        counted_list elements = {1, 2, 3};
+        counted_list other = {7, 8};
+        std::size_t before = Counts::allocations;
+        elements.splice(++elements.begin(), other);
+        CHECK(contents(elements) == std::vector<int>{1, 7, 8, 2, 3});
+        CHECK(elements.size() == 5);
+        CHECK(other.empty());
+        CHECK(other.size() == 0);
+        elements.splice(elements.begin(), other);
+        CHECK(elements.size() == 5);
+        other.splice(other.end(), elements);
+        CHECK(contents(other) == std::vector<int>{1, 7, 8, 2, 3});
+        CHECK(Counts::allocations == before);
+    }
+
+    SECTION("splicing one element") {
+        counted_list elements = {1, 2, 3};
+        counted_list other = {7, 8};
+        std::size_t before = Counts::allocations;
+        elements.splice(elements.end(), other, other.begin());
+        CHECK(contents(elements) == std::vector<int>{1, 2, 3, 7});
+        CHECK(contents(other) == std::vector<int>{8});
+        CHECK(other.size() == 1);
+        // within the same list
+        elements.splice(elements.begin(), elements, --elements.end());
+        CHECK(contents(elements) == std::vector<int>{7, 1, 2, 3});
+        elements.splice(elements.begin(), elements, elements.begin());
+        CHECK(contents(elements) == std::vector<int>{7, 1, 2, 3});
+        CHECK(elements.size() == 4);
+        CHECK(Counts::allocations == before);
+    }
+
+    SECTION("splicing a range") {
+        counted_list elements = {1, 2, 3};
+        counted_list other = {6, 7, 8, 9};
+        std::size_t before = Counts::allocations;
+        elements.splice(++elements.begin(), other, ++other.begin(), --other.end());
+        CHECK(contents(elements) == std::vector<int>{1, 7, 8, 2, 3});
+        CHECK(contents(other) == std::vector<int>{6, 9});
+        CHECK(elements.size() == 5);
+        CHECK(other.size() == 2);
+        elements.splice(elements.begin(), elements, ++elements.begin(), elements.end());
+        CHECK(contents(elements) == std::vector<int>{7, 8, 2, 3, 1});
+        CHECK(elements.back() == 1);
+        CHECK(Counts::allocations == before);
+    }
+
+    SECTION("sorting, merging and reversing") {
+        std::vector<int> values = scrambled((std::size_t)GENERATE(0, 1, 2, 3, 100, 1000));
+        counted_list elements = from<counted_list>(values);
+        std::size_t half = values.size() / 2;
+        counted_list other;
+        for (std::size_t i = 0; i < half; i++) {
+            other.push_back(values[i] + 1);
+        }
+        std::size_t before = Counts::allocations;
+
+        elements.sort();
+        std::vector<int> expected = values;
+        std::sort(expected.begin(), expected.end());
+        CHECK(contents(elements) == expected);
+
+        other.sort();
+        elements.merge(other);
+        for (std::size_t i = 0; i < half; i++) {
+            expected.push_back(values[i] + 1);
+        }
+        std::sort(expected.begin(), expected.end());
+        CHECK(contents(elements) == expected);
+        CHECK(elements.size() == expected.size());
+        CHECK(other.empty());
+
+        elements.reverse();
+        std::reverse(expected.begin(), expected.end());
+        CHECK(contents(elements) == expected);
+        CHECK(std::vector<int>(elements.rbegin(), elements.rend()) == std::vector<int>(expected.rbegin(), expected.rend()));
+        CHECK(Counts::allocations == before);
+    }
+
+    SECTION("removing elements") {
+        counted_list elements = {1, 1, 2, 3, 3, 3, 1, 4};
+        CHECK(elements.unique() == 3);
+        CHECK(contents(elements) == std::vector<int>{1, 2, 3, 1, 4});
+        CHECK(elements.remove(elements.front()) == 2);
+        CHECK(contents(elements) == std::vector<int>{2, 3, 4});
+        CHECK(elements.remove_if([](int element) { return element % 2 == 0; }) == 2);
+        CHECK(contents(elements) == std::vector<int>{3});
+        CHECK(elements.size() == 1);
+        CHECK(elements.remove(3) == 1);
+        CHECK(elements.empty());
+        elements.push_back(5);
+        CHECK(contents(elements) == std::vector<int>{5});
+    }
+}
+
+TEST_CASE("list sort() and merge() keep the order of equal elements") {
+    std::vector<std::pair<int, int>> values;
+    for (int element : scrambled(500)) {
+        values.emplace_back(element % 10, (int)values.size());
+    }
+    auto by_first = [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; };
+    auto elements = from<list<std::pair<int, int>>>(values);
+    elements.sort(by_first);
+    std::stable_sort(values.begin(), values.end(), by_first);
+    CHECK(contents(elements) == values);
+
+    list<std::pair<int, int>> other = {{0, -1}, {5, -1}, {9, -1}};
+    elements.merge(other, by_first);
+    std::vector<std::pair<int, int>> extra = {{0, -1}, {5, -1}, {9, -1}};
+    std::vector<std::pair<int, int>> expected(values.size() + 3);
+    std::merge(values.begin(), values.end(), extra.begin(), extra.end(), expected.begin(), by_first);
+    CHECK(contents(elements) == expected);
+}
+
+TEST_CASE("list sort() keeps every element if the comparison throws") {
+    std::vector<int> values = scrambled(300);
+    auto elements = from<list<int>>(values);
+    int comparisons = 0;
+    CHECK_THROWS_AS(
+        elements.sort([&comparisons](int lhs, int rhs) {
+            if (++comparisons == 1000) {
+                throw std::runtime_error("comparison failed");
+            }
+            return lhs < rhs;
+        }),
+        std::runtime_error
+    );
+    CHECK(elements.size() == values.size());
+    std::vector<int> kept = contents(elements);
+    std::sort(kept.begin(), kept.end());
+    std::sort(values.begin(), values.end());
+    CHECK(kept == values);
+    CHECK(std::vector<int>(elements.rbegin(), elements.rend()).size() == values.size());
+}
+
+TEST_CASE("list operations can be used in constant expressions") {
+    STATIC_REQUIRE(sorted_and_merged(40) == 4147);
+}
+
+TEST_CASE("list can be moved without copying any nodes") {
+    using counted_list = list<int, CountingAllocator<int>>;
+
+    SECTION("an empty list allocates nothing") {
+        std::size_t before = Counts::allocations;
+        counted_list empty;
+        CHECK(empty.empty());
+        CHECK(empty.begin() == empty.end());
+        counted_list moved = std::move(empty);
+        CHECK(moved.empty());
+        CHECK(Counts::allocations == before);
+    }
+
+    SECTION("moving") {
+        counted_list elements = {1, 2, 3};
+        std::size_t before = Counts::allocations;
+        counted_list moved = std::move(elements);
+        CHECK(contents(moved) == std::vector<int>{1, 2, 3});
+        CHECK(std::vector<int>(moved.rbegin(), moved.rend()) == std::vector<int>{3, 2, 1});
+        CHECK(moved.size() == 3);
+        CHECK(elements.empty());
+        CHECK(elements.size() == 0);
+        elements = std::move(moved);
+        CHECK(contents(elements) == std::vector<int>{1, 2, 3});
+        CHECK(moved.empty());
+        elements = std::move(elements);
+        CHECK(elements.size() == 3);
+        CHECK(Counts::allocations == before);
+        // a moved-from list can be used again
+        moved.push_back(4);
+        CHECK(contents(moved) == std::vector<int>{4});
+    }
+
+    SECTION("swapping relinks both ends") {
+        counted_list elements = {1, 2, 3};
+        counted_list other;
+        elements.swap(other);
+        CHECK(elements.empty());
+        CHECK(contents(other) == std::vector<int>{1, 2, 3});
+        other.swap(elements);
+        elements.pop_back();
+        elements.push_front(0);
+        CHECK(contents(elements) == std::vector<int>{0, 1, 2});
+        CHECK(other.empty());
+    }
+}
+
+TEST_CASE("list constructs elements in place") {
+    Copies::count = 0;
+    list<Copies> elements;
+    elements.emplace_back(2);
+    elements.emplace_front(1);
+    elements.push_back(Copies(3));
+    elements.push_front(Copies(0));
+    CHECK(elements.emplace_back(4).value == 4);
+    CHECK(elements.size() == 5);
+    CHECK(Copies::count == 0);
+    int expected = 0;
+    for (const Copies& element : elements) {
+        CHECK(element.value == expected++);
+    }
+
+    list<std::unique_ptr<std::string>> owners;
+    owners.push_back(std::make_unique<std::string>("b"));
+    owners.emplace_front(new std::string("a"));
+    CHECK(*owners.front() == "a");
+    CHECK(*owners.back() == "b");
+    list<std::unique_ptr<std::string>> moved = std::move(owners);
+    CHECK(*moved.back() == "b");
+}
+
+TEST_CASE("list can be moved in constant expressions") {
+    STATIC_REQUIRE(moved_and_swapped(10) == 9 + 100 + 10);
+}
@@ -0,0 +1,135 @@
+#if defined(__unix__) or defined(__APPLE__)
+
+#include <cstddef>
+#include <cstdint>
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+#include <catch2/catch_all.hpp>
+
+#include <codlili/mapped_sharray.hpp>
+#include <codlili/sharray.hpp>
+
+
+using namespace com::saxbophone::codlili;
+
+namespace {
+    struct Point {
+        double x;
+        double y;
+
+        bool operator==(const Point&) const = default;
+    };
+
+    // a file in the temporary directory, removed when it goes out of scope
+    struct TemporaryFile {
+        TemporaryFile(const std::string& name)
+          : path(std::filesystem::temp_directory_path() / ("codlili-" + name))
+          {}
+        ~TemporaryFile() { std::filesystem::remove(path); }
+
+        std::filesystem::path path;
+    };
+}
+
+TEST_CASE("sharray can be saved and mapped back without copying") {
+    TemporaryFile file("mapped_sharray.bin");
+
+    SECTION("integers, with headroom at the front") {
+        sharray<int> array = {3, 4, 5};
+        array.push_front(2);
+        array.push_front(1);
+        save(array, file.path);
+
+        mapped_sharray<int> mapped(file.path);
+
+        REQUIRE(mapped.size() == 5);
+        CHECK(mapped.front() == 1);
+        CHECK(mapped.back() == 5);
+        CHECK(mapped[2] == 3);
+        CHECK(mapped.at(3) == 4);
+        CHECK_THROWS_AS(mapped.at(5), std::out_of_range);
+        CHECK(sharray<int>(mapped.begin(), mapped.end()) == array);
+        CHECK(sharray<int>(mapped.rbegin(), mapped.rend()) == sharray<int>({5, 4, 3, 2, 1}));
+        CHECK(mapped.contains(4));
+        CHECK(*mapped.find(5) == 5);
+        CHECK(mapped.count(6) == 0);
+        // the elements are aligned within the file
+        CHECK(reinterpret_cast<std::uintptr_t>(mapped.data()) % 64 == 0);
+    }
+    SECTION("structs") {
+        sharray<Point> array = {{1.0, 2.0}, {3.0, 4.0}};
+        save(array, file.path);
+
+        mapped_sharray<Point> mapped(file.path);
+
+        REQUIRE(mapped.size() == 2);
+        CHECK(mapped.back() == Point{3.0, 4.0});
+    }
+    SECTION("empty arrays") {
+        save(sharray<int>(), file.path);
+
+        mapped_sharray<int> mapped(file.path);
+
+        CHECK(mapped.empty());
+        CHECK(mapped.begin() == mapped.end());
+    }
+    SECTION("large arrays") {
+        sharray<std::uint64_t> array;
+        for (std::uint64_t i = 0; i < 100000; i++) {
+            array.push_back(i * i);
+        }
+        save(array, file.path);
+
+        mapped_sharray<std::uint64_t> mapped(file.path);
+
+        REQUIRE(mapped.size() == array.size());
+        CHECK(std::equal(mapped.begin(), mapped.end(), array.begin()));
+    }
+    SECTION("moving a mapping hands it over") {
+        save(sharray<int>({1, 2, 3}), file.path);
+        mapped_sharray<int> mapped(file.path);
+
+        mapped_sharray<int> moved = std::move(mapped);
+
+        CHECK(mapped.empty());
+        CHECK(moved.size() == 3);
+        CHECK(moved.back() == 3);
+    }
+}
+
+TEST_CASE("mapped_sharray rejects files it can't read") {
+    TemporaryFile file("mapped_sharray_invalid.bin");
+
+    SECTION("missing files") {
+        CHECK_THROWS_AS(mapped_sharray<int>(file.path), std::system_error);
+    }
+    SECTION("files which aren't sharrays") {
+        std::ofstream(file.path) << "this is not the sharray you're looking for, not by a long way";
+
+        CHECK_THROWS_AS(mapped_sharray<int>(file.path), std::runtime_error);
+    }
+    SECTION("files which are too short") {
+        std::ofstream(file.path) << "short";
+
+        CHECK_THROWS_AS(mapped_sharray<int>(file.path), std::runtime_error);
+    }
+    SECTION("files of a different element type") {
+        save(sharray<double>({1.0, 2.0}), file.path);
+
+        CHECK_THROWS_AS(mapped_sharray<int>(file.path), std::runtime_error);
+    }
+    SECTION("truncated files") {
+        save(sharray<int>({1, 2, 3, 4}), file.path);
+        std::filesystem::resize_file(file.path, std::filesystem::file_size(file.path) - 1);
+
+        CHECK_THROWS_AS(mapped_sharray<int>(file.path), std::runtime_error);
+    }
+}
+
+#endif
@@ -0,0 +1,168 @@
+#ifdef __linux__
+
+#include <cstddef>
+
+#include <numeric>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include <codlili/mmap_allocator.hpp>
+#include <codlili/sharray.hpp>
+
+
+using namespace com::saxbophone::codlili;
+
+namespace {
+    // mmap_allocator which counts how many times storage has been allocated and remapped
+    template <typename T>
+    struct CountingMmapAllocator : mmap_allocator<T> {
+        static inline std::size_t allocations = 0;
+        static inline std::size_t remaps = 0;
+
+        template <typename U>
+        struct rebind {
+            using other = CountingMmapAllocator<U>;
+        };
+
+        CountingMmapAllocator() = default;
+        template <typename U>
+        CountingMmapAllocator(const CountingMmapAllocator<U>&) {}
+
+        T* allocate(std::size_t n) {
+            allocations++;
+            return mmap_allocator<T>::allocate(n);
+        }
+        T* reallocate(T* p, std::size_t old_n, std::size_t new_n, std::size_t offset) {
+            remaps++;
+            return mmap_allocator<T>::reallocate(p, old_n, new_n, offset);
+        }
+
+        static void reset() { allocations = 0; remaps = 0; }
+    };
+
+    // an element type which can't be remapped, as it must be moved with its constructor
+    struct Tracked {
+        Tracked(int value) : value(value) {}
+        Tracked(const Tracked& other) : value(other.value) {}
+        bool operator==(const Tracked&) const = default;
+
+        int value;
+    };
+}
+
+TEST_CASE("mmap_allocator allocates usable page-backed storage") {
+    mmap_allocator<int> allocator;
+    int* data = allocator.allocate(10000);
+    for (int i = 0; i < 10000; i++) {
+        data[i] = i;
+    }
+
+    SECTION("remapping keeps the contents") {
+        data = allocator.reallocate(data, 10000, 100000, 0);
+        data[99999] = 99999;
+        CHECK(data[0] == 0);
+        CHECK(data[9999] == 9999);
+        CHECK(data[99999] == 99999);
+        allocator.deallocate(data, 100000);
+    }
+
+    SECTION("remapping at an offset moves the contents up") {
+        std::size_t offset = mmap_allocator<int>::remap_granularity() / sizeof(int) * 3;
+        data = allocator.reallocate(data, 10000, 100000, offset);
+        CHECK(data[offset] == 0);
+        CHECK(data[offset + 9999] == 9999);
+        // the space before the offset is fresh zeroed memory
+        CHECK(data[0] == 0);
+        CHECK(data[offset - 1] == 0);
+        allocator.deallocate(data, 100000);
+    }
+}
+
+TEST_CASE("sharray remaps storage from mmap_allocator instead of moving elements") {
+    using Array = sharray<float, CountingMmapAllocator<float>>;
+    const int count = 1000000;
+    CountingMmapAllocator<float>::reset();
+
+    SECTION("growing at the back") {
+        Array array;
+        for (int i = 0; i < count; i++) {
+            array.push_back((float)i);
+        }
+
+        CHECK(CountingMmapAllocator<float>::remaps > 0);
+        REQUIRE(array.size() == (std::size_t)count);
+        for (int i = 0; i < count; i++) {
+            REQUIRE(array[(std::size_t)i] == (float)i);
+        }
+    }
+
+    SECTION("growing at the front") {
+        Array array;
+        for (int i = 0; i < count; i++) {
+            array.push_front((float)i);
+        }
+
+        CHECK(CountingMmapAllocator<float>::remaps > 0);
+        // the new elements are constructed in the remapped storage, so nothing else is allocated
+        CHECK(CountingMmapAllocator<float>::allocations == 1);
+        REQUIRE(array.size() == (std::size_t)count);
+        for (int i = 0; i < count; i++) {
+            REQUIRE(array[(std::size_t)i] == (float)(count - 1 - i));
+        }
+    }
+
+    SECTION("pushing copies of elements which are remapped away") {
+        Array array = {1.0f};
+        for (int i = 0; i < 20; i++) {
+            array.push_back(array.front());
+            array.push_front(array.back());
+        }
+
+        CHECK(CountingMmapAllocator<float>::remaps > 0);
+        // the new elements are constructed in the remapped storage, so nothing else is allocated
+        CHECK(CountingMmapAllocator<float>::allocations == 1);
+        CHECK(array.size() == 41);
+        CHECK(array.count(1.0f) == 41);
+    }
+
+    SECTION("reserving and inserting ranges") {
+        std::vector<float> values(100000);
+        std::iota(values.begin(), values.end(), 0.0f);
+        Array array(values.begin(), values.end());
+        array.reserve(400000);
+        CHECK(array.capacity() >= 400000);
+        array.insert(array.end(), values.begin(), values.end());
+        array.insert(array.begin(), values.begin(), values.end());
+
+        CHECK(CountingMmapAllocator<float>::remaps > 0);
+        REQUIRE(array.size() == 300000);
+        for (std::size_t i = 0; i < array.size(); i++) {
+            REQUIRE(array[i] == (float)(i % 100000));
+        }
+    }
+}
+
+TEST_CASE("sharray moves elements which aren't trivially relocatable between mmap_allocator blocks") {
+    sharray<Tracked, mmap_allocator<Tracked>> array;
+    for (int i = 0; i < 10000; i++) {
+        array.push_back(i);
+        array.push_front(-i);
+    }
+
+    REQUIRE(array.size() == 20000);
+    CHECK(array.front() == Tracked(-9999));
+    CHECK(array.back() == Tracked(9999));
+}
+
+TEST_CASE("sharray works with mmap_allocator using huge pages") {
+    sharray<double, mmap_allocator<double, true>> array;
+    for (int i = 0; i < 1000000; i++) {
+        array.push_back(i);
+    }
+
+    CHECK(array.size() == 1000000);
+    CHECK(array.back() == 999999.0);
+}
+
+#endif
@@ -0,0 +1,195 @@
+#include <cstddef>
+#include <cstdint>
+
+#include <memory>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include <codlili/list.hpp>
+#include <codlili/node_pool_allocator.hpp>
+
+#include "helpers.hpp"
+
+
+using namespace com::saxbophone::codlili;
+
+namespace {
+    constexpr int sum_after_churn(int count) {
+        list<int, node_pool_allocator<int, 4>> elements;
+        for (int i = 0; i < count; i++) {
+            elements.push_back(i);
+            if (i % 3 == 0) {
+                elements.pop_front();
+            }
+        }
+        int sum = 0;
+        for (int element : elements) {
+            sum += element;
+        }
+        return sum;
+    }
+}
+
+TEST_CASE("node_pool_allocator carves objects from slabs") {
+    Counts::reset();
+    {
+        node_pool_allocator<std::uint64_t, 8, CountingAllocator<std::uint64_t>> allocator;
+        // the pools the allocator shares with its copies
+        CHECK(Counts::allocations == 1);
+        std::vector<std::uint64_t*> objects;
+        for (std::uint64_t i = 0; i < 20; i++) {
+            objects.push_back(allocator.allocate(1));
+            *objects.back() = i;
+        }
+        // the pool for std::uint64_t, and 20 objects in 3 slabs of 8
+        CHECK(Counts::allocations == 5);
+        CHECK(std::set<std::uint64_t*>(objects.begin(), objects.end()).size() == 20);
+        // objects from the same slab are next to each other
+        for (std::size_t i = 1; i < 8; i++) {
+            CHECK(objects[i] == objects[i - 1] + 1);
+        }
+        for (std::size_t i = 0; i < 20; i++) {
+            CHECK(*objects[i] == i);
+        }
+
+        SECTION("objects given back are reused, most recent first") {
+            allocator.deallocate(objects[3], 1);
+            allocator.deallocate(objects[17], 1);
+            CHECK(allocator.allocate(1) == objects[17]);
+            CHECK(allocator.allocate(1) == objects[3]);
+            CHECK(Counts::allocations == 5);
+        }
+
+        SECTION("allocations of more than one object go upstream") {
+            std::uint64_t* many = allocator.allocate(100);
+            CHECK(Counts::allocations == 6);
+            allocator.deallocate(many, 100);
+            CHECK(Counts::outstanding == 5);
+        }
+    }
+    // slabs are given back when the allocator is destroyed
+    CHECK(Counts::outstanding == 0);
+}
+
+TEST_CASE("copies of node_pool_allocator share a pool") {
+    Counts::reset();
+    {
+        node_pool_allocator<int, 8, CountingAllocator<int>> allocator;
+        int* object;
+        {
+            auto copy = allocator;
+            CHECK(copy == allocator);
+            object = copy.allocate(1);
+        }
+        // the pools, the pool for int and its slab outlive the copy which allocated from them
+        CHECK(Counts::outstanding == 3);
+        allocator.deallocate(object, 1);
+        CHECK(allocator.allocate(1) == object);
+
+        node_pool_allocator<int, 8, CountingAllocator<int>> other;
+        CHECK(other != allocator);
+        other = allocator;
+        CHECK(other == allocator);
+        CHECK(Counts::outstanding == 3);
+
+        SECTION("rebound copies share the pools, with a pool for each type") {
+            node_pool_allocator<double, 8, CountingAllocator<int>> rebound(allocator);
+            CHECK(rebound == allocator);
+            CHECK(allocator == rebound);
+            CHECK(rebound != node_pool_allocator<double, 8, CountingAllocator<int>>());
+            CHECK(node_pool_allocator<int, 8, CountingAllocator<int>>(rebound) == allocator);
+            double* rebound_object = rebound.allocate(1);
+            // a pool for double and its slab
+            CHECK(Counts::outstanding == 5);
+            rebound.deallocate(rebound_object, 1);
+            CHECK(rebound.allocate(1) == rebound_object);
+            // the copy back finds the same pool for int
+            node_pool_allocator<int, 8, CountingAllocator<int>> back(rebound);
+            back.deallocate(allocator.allocate(1), 1);
+            CHECK(Counts::outstanding == 5);
+        }
+    }
+    CHECK(Counts::outstanding == 0);
+}
+
+TEST_CASE("list allocates its nodes with its allocator") {
+    Counts::reset();
+    {
+        list<int, node_pool_allocator<int, 64, CountingAllocator<int>>> elements;
+        for (int i = 0; i < 1000; i++) {
+            elements.push_back(i);
+            if (i % 2 == 0) {
+                elements.pop_front();
+            }
+        }
+        CHECK(elements.size() == 500);
+        CHECK(elements.front() == 500);
+        CHECK(elements.back() == 999);
+        // the pools, the pool for nodes and 8 slabs for 500 nodes, with all nodes popped reused
+        CHECK(Counts::allocations == 10);
+
+        auto copy = elements;
+        CHECK(copy == elements);
+        // the copy shares the pools, so only needs more slabs
+        CHECK(Counts::allocations == 18);
+        elements.clear();
+        elements = copy;
+        CHECK(elements == copy);
+        elements.swap(copy);
+        CHECK(elements == copy);
+    }
+    CHECK(Counts::outstanding == 0);
+
+    SECTION("the allocator of the list compares equal to the one it was built from") {
+        node_pool_allocator<int, 64, CountingAllocator<int>> allocator;
+        list<int, node_pool_allocator<int, 64, CountingAllocator<int>>> built(allocator);
+        CHECK(built.get_allocator() == allocator);
+    }
+
+    SECTION("with the default allocator") {
+        list<int, std::allocator<int>> defaulted(3, 7, std::allocator<int>());
+        CHECK(defaulted == list<int>{7, 7, 7});
+    }
+}
+
+TEST_CASE("lists built from the same node_pool_allocator can splice between each other") {
+    Counts::reset();
+    {
+        using Allocator = node_pool_allocator<int, 4, CountingAllocator<int>>;
+        Allocator allocator;
+        list<int, Allocator> destination(allocator);
+        {
+            list<int, Allocator> source(allocator);
+            for (int i = 0; i < 10; i++) {
+                source.push_back(i);
+                destination.push_back(-i);
+            }
+            destination.splice(destination.begin(), source);
+            CHECK(source.empty());
+            // the source goes first, but the pool its nodes came from stays
+        }
+        CHECK(destination.size() == 20);
+        CHECK(destination.front() == 0);
+        CHECK(destination.back() == -9);
+        for (int i = 0; i < 100; i++) {
+            destination.push_back(i);
+            destination.pop_front();
+        }
+        CHECK(destination.size() == 20);
+        CHECK(destination.front() == 80);
+        // a list moved into one with an equal allocator takes its nodes
+        std::size_t allocations = Counts::allocations;
+        list<int, Allocator> moved(std::move(destination), allocator);
+        CHECK(Counts::allocations == allocations);
+        CHECK(moved.size() == 20);
+        CHECK(moved.back() == 99);
+    }
+    CHECK(Counts::outstanding == 0);
+}
+
+TEST_CASE("list and node_pool_allocator can be used in constant expressions") {
+    STATIC_REQUIRE(sum_after_churn(100) == 4389);
+}
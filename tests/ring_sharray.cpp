@@ -0,0 +1,261 @@
+#include <cstddef>
+
+#include <algorithm>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include <codlili/ring_sharray.hpp>
+
+#include "helpers.hpp"
+
+
+using namespace com::saxbophone::codlili;
+
+namespace {
+    constexpr int sum_after_wrapping(int count) {
+        ring_sharray<int> ring;
+        ring.reserve(4);
+        for (int i = 0; i < count; i++) {
+            ring.push_back(i);
+            if (ring.size() == 4) {
+                ring.pop_front();
+            }
+        }
+        int sum = 0;
+        for (int element : ring) {
+            sum += element;
+        }
+        return sum;
+    }
+}
+
+static_assert(std::random_access_iterator<ring_sharray<int>::iterator>);
+static_assert(std::random_access_iterator<ring_sharray<int>::const_iterator>);
+
+TEST_CASE("ring_sharray mirrors the API of sharray") {
+    using array_type = ring_sharray<int>;
+
+    SECTION("construction") {
+        CHECK(array_type().empty());
+        CHECK(array_type(10, 7).size() == 10);
+        CHECK(array_type(10, 7).back() == 7);
+        CHECK(array_type(10).front() == 0);
+        std::vector<int> source = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+        CHECK(std::ranges::equal(array_type(source.begin(), source.end()), source));
+        CHECK(std::ranges::equal(array_type({1, 2, 3}), std::vector<int>{1, 2, 3}));
+    }
+    SECTION("pushing and popping at both ends") {
+        array_type array;
+        for (int i = 0; i < 10; i++) {
+            array.push_back(i);
+            array.push_front(-i);
+        }
+
+        REQUIRE(array.size() == 20);
+        CHECK(array.front() == -9);
+        CHECK(array.back() == 9);
+        CHECK(array[9] == 0);
+        CHECK(array[10] == 0);
+        CHECK(array.at(19) == 9);
+        CHECK_THROWS_AS(array.at(20), std::out_of_range);
+
+        for (int i = 0; i < 5; i++) {
+            array.pop_back();
+            array.pop_front();
+        }
+        CHECK(std::ranges::equal(array, std::vector<int>{-4, -3, -2, -1, 0, 0, 1, 2, 3, 4}));
+    }
+    SECTION("resizing") {
+        array_type array = {1, 2, 3};
+
+        array.resize(6, 9);
+        CHECK(std::ranges::equal(array, std::vector<int>{1, 2, 3, 9, 9, 9}));
+        array.resize(2);
+        CHECK(std::ranges::equal(array, std::vector<int>{1, 2}));
+        array.resize(3);
+        CHECK(std::ranges::equal(array, std::vector<int>{1, 2, 0}));
+    }
+    SECTION("iterators") {
+        array_type array = {3, 4, 5, 6};
+        array.push_front(2);
+        array.push_front(1);
+
+        std::vector<int> reversed(array.rbegin(), array.rend());
+        CHECK(reversed == std::vector<int>{6, 5, 4, 3, 2, 1});
+        CHECK(array.end() - array.begin() == 6);
+        array_type::const_iterator it = array.begin() + 4;
+        CHECK(*it == 5);
+        CHECK(it[-1] == 4);
+        std::ranges::sort(array, std::greater<>());
+        CHECK(std::ranges::equal(array, reversed));
+    }
+    SECTION("search and comparison") {
+        array_type array = {5, 2, 5, 3, 5};
+        array.push_front(1);
+        array.push_front(5);
+
+        CHECK(array.count(5) == 4);
+        CHECK(array.find(2) == array.begin() + 3);
+        CHECK(array.find(9) == array.end());
+        CHECK(array.contains(3));
+        CHECK(array == array_type({5, 1, 5, 2, 5, 3, 5}));
+        CHECK(array != array_type({5, 1, 5}));
+        CHECK(array < array_type({5, 2}));
+    }
+    SECTION("copying, moving and swapping") {
+        ring_sharray<std::string> array = {"b", "c", "d", "e"};
+        array.push_front("a");
+        ring_sharray<std::string> copy = array;
+        CHECK(copy == array);
+
+        ring_sharray<std::string> moved = std::move(copy);
+        CHECK(moved == array);
+        CHECK(copy.empty());
+
+        ring_sharray<std::string> other = {"z"};
+        other.swap(moved);
+        CHECK(other == array);
+        CHECK(moved == ring_sharray<std::string>({"z"}));
+
+        moved = other;
+        CHECK(moved == array);
+        moved = {"y"};
+        CHECK(moved.size() == 1);
+        moved = std::move(other);
+        CHECK(moved == array);
+    }
+    SECTION("pushing copies of its own elements while growing") {
+        ring_sharray<std::string> array = {"first"};
+        for (int i = 0; i < 20; i++) {
+            array.push_back(array.front());
+            array.push_front(array.back());
+        }
+        CHECK(array.size() == 41);
+        CHECK(array.count("first") == 41);
+    }
+}
+
+TEST_CASE("ring_sharray wraps around instead of allocating") {
+    CountingAllocator<int>::allocations = 0;
+    ring_sharray<int, CountingAllocator<int>> queue;
+    queue.reserve(100);
+    REQUIRE(CountingAllocator<int>::allocations == 1);
+
+    SECTION("as a queue at constant occupancy") {
+        for (int i = 0; i < 100000; i++) {
+            queue.push_back(i);
+            if (queue.size() > 50) {
+                REQUIRE(queue.front() == i - 50);
+                queue.pop_front();
+            }
+        }
+        CHECK(queue.capacity() == 100);
+    }
+
+    SECTION("as a queue going the other way") {
+        for (int i = 0; i < 100000; i++) {
+            queue.push_front(i);
+            if (queue.size() > 99) {
+                REQUIRE(queue.back() == i - 99);
+                queue.pop_back();
+            }
+        }
+        CHECK(queue.capacity() == 100);
+    }
+
+    SECTION("bounded with try_push") {
+        int pushed = 0;
+        while (queue.try_push_back(pushed)) {
+            pushed++;
+        }
+        CHECK(pushed == 100);
+        CHECK(queue.full());
+        CHECK(not queue.try_push_front(-1));
+        queue.pop_front();
+        CHECK(queue.try_emplace_front(-1));
+        CHECK(queue.front() == -1);
+        CHECK(queue.back() == 99);
+    }
+
+    CHECK(CountingAllocator<int>::allocations == 1);
+}
+
+TEST_CASE("ring_sharray exposes its elements as two spans") {
+    ring_sharray<int> ring;
+    ring.reserve(8);
+
+    SECTION("when not wrapped around") {
+        ring.push_back(1);
+        ring.push_back(2);
+        auto [first, second] = ring.spans();
+        CHECK(std::ranges::equal(first, std::vector<int>{1, 2}));
+        CHECK(second.empty());
+    }
+
+    SECTION("when wrapped around") {
+        for (int i = 0; i < 8; i++) {
+            ring.push_back(i);
+        }
+        for (int i = 0; i < 5; i++) {
+            ring.pop_front();
+        }
+        for (int i = 8; i < 12; i++) {
+            ring.push_back(i);
+        }
+        const auto& view = ring;
+        auto [first, second] = view.spans();
+        CHECK(std::ranges::equal(first, std::vector<int>{5, 6, 7}));
+        CHECK(std::ranges::equal(second, std::vector<int>{8, 9, 10, 11}));
+        CHECK(ring.capacity() == 8);
+    }
+}
+
+TEST_CASE("ring_sharray behaves like std::deque") {
+    ring_sharray<std::string> ring;
+    std::deque<std::string> deque;
+    unsigned state = 1;
+    for (int i = 0; i < 5000; i++) {
+        state = state * 1103515245 + 12345;
+        std::string value = std::to_string(i);
+        switch ((state >> 16) % 6) {
+        case 0:
+            ring.push_back(value);
+            deque.push_back(value);
+            break;
+        case 1:
+            ring.push_front(value);
+            deque.push_front(value);
+            break;
+        case 2:
+            if (not deque.empty()) {
+                ring.pop_back();
+                deque.pop_back();
+            }
+            break;
+        case 3:
+            if (not deque.empty()) {
+                ring.pop_front();
+                deque.pop_front();
+            }
+            break;
+        case 4:
+            ring.shrink_to_fit();
+            break;
+        default:
+            ring.emplace_back(value);
+            deque.emplace_back(value);
+        }
+        REQUIRE(std::ranges::equal(ring, deque));
+    }
+}
+
+TEST_CASE("ring_sharray can be used in constant expressions") {
+    STATIC_REQUIRE(sum_after_wrapping(3) == 3);
+    STATIC_REQUIRE(sum_after_wrapping(100) == 97 + 98 + 99);
+}
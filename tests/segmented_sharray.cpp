@@ -0,0 +1,202 @@
+#include <cstddef>
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include <codlili/segmented_sharray.hpp>
+
+#include "helpers.hpp"
+
+
+using namespace com::saxbophone::codlili;
+
+static_assert(std::random_access_iterator<segmented_sharray<int>::iterator>);
+static_assert(std::random_access_iterator<segmented_sharray<int>::const_iterator>);
+
+TEST_CASE("segmented_sharray mirrors the API of sharray") {
+    using array_type = segmented_sharray<int, 4>;
+
+    SECTION("construction") {
+        CHECK(array_type().empty());
+        CHECK(array_type(10, 7).size() == 10);
+        CHECK(array_type(10, 7).back() == 7);
+        CHECK(array_type(10).front() == 0);
+        std::vector<int> source = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+        CHECK(std::ranges::equal(array_type(source.begin(), source.end()), source));
+        CHECK(std::ranges::equal(array_type({1, 2, 3}), std::vector<int>{1, 2, 3}));
+    }
+    SECTION("pushing and popping at both ends") {
+        array_type array;
+        for (int i = 0; i < 10; i++) {
+            array.push_back(i);
+            array.push_front(-i);
+        }
+
+        REQUIRE(array.size() == 20);
+        CHECK(array.front() == -9);
+        CHECK(array.back() == 9);
+        CHECK(array[9] == 0);
+        CHECK(array[10] == 0);
+        CHECK(array.at(19) == 9);
+        CHECK_THROWS_AS(array.at(20), std::out_of_range);
+
+        for (int i = 0; i < 5; i++) {
+            array.pop_back();
+            array.pop_front();
+        }
+        CHECK(std::ranges::equal(array, std::vector<int>{-4, -3, -2, -1, 0, 0, 1, 2, 3, 4}));
+    }
+    SECTION("insertion and erasure in the middle") {
+        array_type array = {1, 2, 3, 4, 5, 6, 7, 8};
+
+        CHECK(*array.insert(array.begin() + 2, 20) == 20);
+        CHECK(*array.insert(array.end() - 1, 2, 70) == 70);
+        std::vector<int> more = {41, 42, 43};
+        CHECK(*array.insert(array.begin() + 5, more.begin(), more.end()) == 41);
+        CHECK(std::ranges::equal(array, std::vector<int>{1, 2, 20, 3, 4, 41, 42, 43, 5, 6, 7, 70, 70, 8}));
+
+        CHECK(*array.erase(array.begin() + 2) == 3);
+        CHECK(*array.erase(array.begin() + 4, array.begin() + 7) == 5);
+        CHECK(std::ranges::equal(array, std::vector<int>{1, 2, 3, 4, 5, 6, 7, 70, 70, 8}));
+    }
+    SECTION("resizing") {
+        array_type array = {1, 2, 3};
+
+        array.resize(6, 9);
+        CHECK(std::ranges::equal(array, std::vector<int>{1, 2, 3, 9, 9, 9}));
+        array.resize(2);
+        CHECK(std::ranges::equal(array, std::vector<int>{1, 2}));
+    }
+    SECTION("iterators") {
+        array_type array = {1, 2, 3, 4, 5, 6};
+
+        std::vector<int> reversed(array.rbegin(), array.rend());
+        CHECK(reversed == std::vector<int>{6, 5, 4, 3, 2, 1});
+        CHECK(array.end() - array.begin() == 6);
+        array_type::const_iterator it = array.begin() + 4;
+        CHECK(*it == 5);
+        CHECK(it[-1] == 4);
+        std::ranges::sort(array, std::greater<>());
+        CHECK(std::ranges::equal(array, reversed));
+    }
+    SECTION("search and comparison") {
+        array_type array = {5, 1, 5, 2, 5, 3, 5};
+
+        CHECK(array.count(5) == 4);
+        CHECK(array.find(2) == array.begin() + 3);
+        CHECK(array.find(9) == array.end());
+        CHECK(array.contains(3));
+        CHECK(array == array_type({5, 1, 5, 2, 5, 3, 5}));
+        CHECK(array != array_type({5, 1, 5}));
+        CHECK(array < array_type({5, 2}));
+    }
+    SECTION("copying, moving and swapping") {
+        segmented_sharray<std::string, 2> array = {"a", "b", "c", "d", "e"};
+        segmented_sharray<std::string, 2> copy = array;
+        CHECK(copy == array);
+
+        segmented_sharray<std::string, 2> moved = std::move(copy);
+        CHECK(moved == array);
+        CHECK(copy.empty());
+
+        segmented_sharray<std::string, 2> other = {"z"};
+        other.swap(moved);
+        CHECK(other == array);
+        CHECK(moved == segmented_sharray<std::string, 2>({"z"}));
+
+        moved = other;
+        CHECK(moved == array);
+        moved = {"y"};
+        CHECK(moved.size() == 1);
+    }
+}
+
+TEST_CASE("segmented_sharray grows by whole chunks without moving elements") {
+    CountingAllocator<int>::allocations = 0;
+    segmented_sharray<int, 64, CountingAllocator<int>> array;
+    array.push_back(0);
+    const int* first = &array.front();
+
+    for (int i = 1; i < 64 * 100; i++) {
+        array.push_back(i);
+        array.push_front(-i);
+    }
+
+    // references to elements stay valid, as they're never moved
+    CHECK(&array[64 * 100 - 1] == first);
+    CHECK(*first == 0);
+    // one allocation per chunk, plus the occasional one for the array of chunks
+    CHECK(array.capacity() >= array.size());
+    CHECK(array.capacity() < array.size() + 2 * 64);
+    CHECK(CountingAllocator<int>::allocations < array.capacity() / 64 + 20);
+    for (std::size_t i = 0; i < array.size(); i++) {
+        REQUIRE(array[i] == (int)i - (64 * 100 - 1));
+    }
+}
+
+TEST_CASE("segmented_sharray frees chunks as they empty") {
+    segmented_sharray<int, 16> array;
+    for (int i = 0; i < 160; i++) {
+        array.push_back(i);
+    }
+    REQUIRE(array.capacity() == 160);
+
+    for (int i = 0; i < 40; i++) {
+        array.pop_front();
+        array.pop_back();
+    }
+
+    CHECK(array.size() == 80);
+    // with a spare chunk left at each end
+    CHECK(array.capacity() == 128);
+    array.shrink_to_fit();
+    CHECK(array.capacity() == 96);
+    CHECK(array.front() == 40);
+    CHECK(array.back() == 119);
+    // clearing keeps one chunk
+    array.clear();
+    CHECK(array.capacity() == 16);
+    array.push_front(1);
+    array.push_back(2);
+    CHECK(array.capacity() == 16);
+    array.shrink_to_fit();
+    CHECK(array.capacity() == 16);
+    array.clear();
+    array.shrink_to_fit();
+    CHECK(array.capacity() == 0);
+}
+
+TEST_CASE("segmented_sharray doesn't free and reallocate chunks when pushing and popping across their edges") {
+    segmented_sharray<int, 16, CountingAllocator<int>> array;
+    for (int i = 0; i < 32; i++) {
+        array.push_back(i);
+    }
+    CountingAllocator<int>::allocations = 0;
+    for (int i = 0; i < 100; i++) {
+        array.push_back(i);
+        array.pop_back();
+        array.push_front(i);
+        array.pop_front();
+    }
+    // one chunk at each end, the first time
+    CHECK(CountingAllocator<int>::allocations == 2);
+    // nor when it empties and fills up again
+    while (not array.empty()) {
+        array.pop_back();
+    }
+    for (int i = 0; i < 16; i++) {
+        array.push_back(i);
+    }
+    CHECK(CountingAllocator<int>::allocations == 2);
+}
+
+TEST_CASE("segmented_sharray can be used in constant expressions") {
+    STATIC_REQUIRE(sum_of_pushes<segmented_sharray<int, 4>>(3) == 3);
+    STATIC_REQUIRE(sum_of_pushes<segmented_sharray<int, 4>>(100) == 4950);
+}
@@ -1,11 +1,26 @@
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
 
+#include <algorithm>
+#include <bit>
+#include <compare>
+#include <iterator>
+#include <memory_resource>
+#include <ranges>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
 #include <vector>
 
 #include <catch2/catch_all.hpp>
 
 #include <codlili/sharray.hpp>
 
+#include "helpers.hpp"
+
 
 using namespace com::saxbophone::codlili;
 
@@ -171,7 +186,13 @@ TEST_CASE("sharray mirrors the API of vector and deque") {
         CHECK(array.capacity() >= size);
     }
     SECTION(".shrink_to_fit()") {
-        WARN("sharray.shrink_to_fit() does nothing. This is standard-compliant.");
+        sharray<int> array(100);
+        array.resize(10);
+
+        array.shrink_to_fit();
+
+        CHECK(array.capacity() == 10);
+        CHECK(array == sharray<int>(10));
     }
     SECTION(".clear()") {
         std::size_t size = (std::size_t)GENERATE(0, 1, 2, 3, 4, 5);
@@ -246,4 +267,938 @@ TEST_CASE("sharray mirrors the API of vector and deque") {
         CHECK(array.size() == resize_to);
         CHECK(array == sharray<int>(resize_to));
     }
+    SECTION(".resize() with value") {
+        sharray<int> array = {1, 2, 3};
+
+        SECTION("grow") {
+            array.resize(5, 9);
+
+            CHECK(array == sharray<int>({1, 2, 3, 9, 9}));
+        }
+        SECTION("shrink") {
+            array.resize(1, 9);
+
+            CHECK(array == sharray<int>({1}));
+        }
+    }
+}
+
+TEST_CASE("sharray can reserve and resize at both ends") {
+    SECTION(".reserve() with pair") {
+        sharray<int> array = {1, 2, 3, 4};
+
+        array.reserve({10, 20});
+        const int* data = array.data();
+        // space is available for 10 push_front() and 16 push_back() without reallocating
+        for (int i = 0; i < 10; i++) {
+            array.push_front(-i);
+        }
+        for (int i = 0; i < 16; i++) {
+            array.push_back(i);
+        }
+
+        CHECK(array.data() == data - 10);
+        CHECK(array.size() == 30);
+        CHECK(array.capacity() >= 30);
+    }
+    SECTION(".reserve() with pair never takes away capacity") {
+        sharray<int> array = {1, 2, 3, 4};
+        array.reserve({10, 20});
+        std::size_t old_capacity = array.capacity();
+
+        array.reserve({0, 4});
+
+        CHECK(array.capacity() == old_capacity);
+        CHECK(array == sharray<int>({1, 2, 3, 4}));
+    }
+    SECTION(".resize() with pair") {
+        sharray<int> array = {1, 2, 3, 4};
+
+        SECTION("grow both ends") {
+            array.resize({2, 6});
+
+            CHECK(array == sharray<int>({0, 0, 1, 2, 3, 4, 0, 0}));
+        }
+        SECTION("grow front, shrink back") {
+            array.resize({1, 2});
+
+            CHECK(array == sharray<int>({0, 1, 2}));
+        }
+        SECTION("with value") {
+            array.resize({3, 5}, 7);
+
+            CHECK(array == sharray<int>({7, 7, 7, 1, 2, 3, 4, 7}));
+        }
+        SECTION("with value referring to own element") {
+            array.resize({3, 0}, array[1]);
+
+            CHECK(array == sharray<int>({2, 2, 2}));
+        }
+    }
+    SECTION("growth puts most spare space at the end being pushed to") {
+        sharray<int> array;
+        for (int i = 0; i < 1000; i++) {
+            array.push_back(i);
+        }
+        const int* data = array.data();
+
+        // at least 3/4 of the storage is at or after the front element
+        array.reserve({0, array.capacity() * 3 / 4});
+
+        CHECK(array.data() == data);
+    }
+    SECTION("skewed pushes reallocate less often than centred growth") {
+        sharray<int> array;
+        std::size_t reallocations = 0;
+        const int* data = nullptr;
+
+        for (int i = 0; i < 10000; i++) {
+            bool front = i % 20 == 0;
+            if (front) {
+                array.push_front(i);
+            } else {
+                array.push_back(i);
+            }
+            // push_front() without reallocating moves data() back by one
+            if (array.data() + (front ? 1 : 0) != data) {
+                reallocations++;
+            }
+            data = array.data();
+        }
+
+        // centred 3x growth would need one reallocation per ~1.5x size
+        CHECK(reallocations < 20);
+    }
+}
+
+namespace {
+    // counts how many times objects of it have been copied or moved
+    struct Counted {
+        static inline std::size_t copies = 0;
+        static inline std::size_t moves = 0;
+
+        Counted(int value = 0) : value(value) {}
+        Counted(const Counted& other) : value(other.value) { copies++; }
+        Counted(Counted&& other) noexcept : value(other.value) { moves++; }
+        Counted& operator=(const Counted& other) = default;
+        Counted& operator=(Counted&& other) noexcept = default;
+        bool operator==(const Counted& other) const = default;
+
+        static void reset() { copies = 0; moves = 0; }
+
+        int value;
+    };
+
+    // as above but with a move constructor that might throw, so must be copied
+    struct ThrowingMove {
+        static inline std::size_t copies = 0;
+
+        ThrowingMove(int value = 0) : value(value) {}
+        ThrowingMove(const ThrowingMove& other) : value(other.value) { copies++; }
+        ThrowingMove(ThrowingMove&& other) : value(other.value) {}
+        ThrowingMove& operator=(const ThrowingMove& other) = default;
+        ThrowingMove& operator=(ThrowingMove&& other) = default;
+        bool operator==(const ThrowingMove& other) const = default;
+
+        int value;
+    };
+
+    // a type which opts in to being relocated with memmove()
+    struct OptedIn {
+        OptedIn(int value = 0) : value(value) {}
+        OptedIn(const OptedIn& other) : value(other.value) {}
+        bool operator==(const OptedIn& other) const = default;
+
+        int value;
+    };
+}
+
+template <>
+struct com::saxbophone::codlili::is_trivially_relocatable<OptedIn> : std::true_type {};
+
+TEST_CASE("sharray relocates elements when reallocating") {
+    SECTION("elements are moved, not copied, by .reserve()") {
+        sharray<Counted> array = {1, 2, 3, 4, 5};
+        Counted::reset();
+
+        array.reserve(100);
+
+        CHECK(Counted::copies == 0);
+        CHECK(Counted::moves == 5);
+        CHECK(array == sharray<Counted>({1, 2, 3, 4, 5}));
+    }
+    SECTION("elements with a throwing move constructor are copied by .reserve()") {
+        sharray<ThrowingMove> array = {1, 2, 3, 4, 5};
+        ThrowingMove::copies = 0;
+
+        array.reserve(100);
+
+        CHECK(ThrowingMove::copies == 5);
+        CHECK(array == sharray<ThrowingMove>({1, 2, 3, 4, 5}));
+    }
+    SECTION("growth by .push_back() and .push_front() preserves elements") {
+        sharray<std::string> array;
+        std::vector<std::string> expected;
+
+        for (int i = 0; i < 100; i++) {
+            array.push_back(std::to_string(i));
+            array.push_front(std::to_string(-i));
+            expected.push_back(std::to_string(i));
+            expected.insert(expected.begin(), std::to_string(-i));
+        }
+
+        CHECK(std::vector<std::string>(array.begin(), array.end()) == expected);
+    }
+    SECTION("types can opt in to trivial relocation") {
+        STATIC_REQUIRE(is_trivially_relocatable_v<int>);
+        STATIC_REQUIRE(is_trivially_relocatable_v<OptedIn>);
+        STATIC_REQUIRE_FALSE(is_trivially_relocatable_v<Counted>);
+        sharray<OptedIn> array = {1, 2, 3, 4, 5};
+
+        array.reserve(100);
+
+        CHECK(array == sharray<OptedIn>({1, 2, 3, 4, 5}));
+    }
+}
+
+TEST_CASE("sharray slides elements along instead of reallocating when there's space") {
+    SECTION("FIFO traffic at constant size stops allocating once warmed up") {
+        sharray<int, CountingAllocator<int>> queue;
+        for (int i = 0; i < 100; i++) {
+            queue.push_back(i);
+        }
+        // warm up
+        for (int i = 0; i < 1000; i++) {
+            queue.push_back(i);
+            queue.pop_front();
+        }
+        CountingAllocator<int>::allocations = 0;
+
+        for (int i = 0; i < 100000; i++) {
+            queue.push_back(i);
+            queue.pop_front();
+        }
+
+        CHECK(CountingAllocator<int>::allocations == 0);
+        CHECK(queue.size() == 100);
+        CHECK(queue.front() == 100000 - 100);
+        CHECK(queue.back() == 100000 - 1);
+    }
+    SECTION("push_front() slides elements when the front is exhausted") {
+        sharray<std::string> array;
+        array.reserve({0, 100});
+        for (int i = 0; i < 10; i++) {
+            array.push_back(std::to_string(i));
+        }
+        std::size_t old_capacity = array.capacity();
+
+        array.push_front("front");
+
+        CHECK(array.capacity() == old_capacity);
+        CHECK(array.front() == "front");
+        CHECK(array.back() == "9");
+        CHECK(array.size() == 11);
+    }
+    SECTION(".reserve() with pair slides elements if there is enough capacity") {
+        sharray<int> array = {1, 2, 3, 4};
+        array.reserve({0, 20});
+        std::size_t old_capacity = array.capacity();
+
+        array.reserve({10, 10});
+
+        CHECK(array.capacity() == old_capacity);
+        CHECK(array == sharray<int>({1, 2, 3, 4}));
+    }
+    SECTION("types which might throw when moved are never slid") {
+        sharray<ThrowingMove, CountingAllocator<ThrowingMove>> array;
+        array.reserve({0, 100});
+        for (int i = 0; i < 10; i++) {
+            array.push_back(i);
+        }
+        CountingAllocator<ThrowingMove>::allocations = 0;
+
+        array.push_front(-1);
+
+        CHECK(CountingAllocator<ThrowingMove>::allocations == 1);
+        CHECK(array.front() == -1);
+        CHECK(array.back() == 9);
+    }
+}
+
+TEST_CASE("sharray insertion and erasure shift the shorter side") {
+    sharray<int> array;
+    array.reserve({20, 20});
+    for (int i = 0; i < 10; i++) {
+        array.push_back(i);
+    }
+    const int* data = array.data();
+
+    SECTION(".insert() near the front shifts the front elements") {
+        auto it = array.insert(array.cbegin() + 2, 42);
+
+        CHECK(*it == 42);
+        CHECK(it == array.begin() + 2);
+        CHECK(array.data() == data - 1);
+        CHECK(array == sharray<int>({0, 1, 42, 2, 3, 4, 5, 6, 7, 8, 9}));
+    }
+    SECTION(".insert() near the back shifts the back elements") {
+        auto it = array.insert(array.cbegin() + 8, 42);
+
+        CHECK(*it == 42);
+        CHECK(array.data() == data);
+        CHECK(array == sharray<int>({0, 1, 2, 3, 4, 5, 6, 7, 42, 8, 9}));
+    }
+    SECTION(".insert() at both ends") {
+        array.insert(array.cbegin(), -1);
+        array.insert(array.cend(), 10);
+
+        CHECK(array == sharray<int>({-1, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10}));
+    }
+    SECTION(".insert() count copies") {
+        auto it = array.insert(array.cbegin() + 3, 3, 7);
+
+        CHECK(it == array.begin() + 3);
+        CHECK(array == sharray<int>({0, 1, 2, 7, 7, 7, 3, 4, 5, 6, 7, 8, 9}));
+    }
+    SECTION(".insert() copies of own element") {
+        array.insert(array.cbegin() + 1, 2, array[5]);
+
+        CHECK(array == sharray<int>({0, 5, 5, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+    }
+    SECTION(".insert() iterator range") {
+        std::vector<int> other = {100, 101, 102};
+
+        auto it = array.insert(array.cbegin() + 7, other.begin(), other.end());
+
+        CHECK(it == array.begin() + 7);
+        CHECK(array == sharray<int>({0, 1, 2, 3, 4, 5, 6, 100, 101, 102, 7, 8, 9}));
+    }
+    SECTION(".insert() initializer list") {
+        array.insert(array.cbegin() + 5, {-1, -2});
+
+        CHECK(array == sharray<int>({0, 1, 2, 3, 4, -1, -2, 5, 6, 7, 8, 9}));
+    }
+    SECTION(".insert() more than fits reallocates") {
+        std::vector<int> other(100, 3);
+
+        array.insert(array.cbegin() + 5, other.begin(), other.end());
+
+        CHECK(array.size() == 110);
+        CHECK(array[4] == 4);
+        CHECK(array[5] == 3);
+        CHECK(array[104] == 3);
+        CHECK(array[105] == 5);
+    }
+    SECTION(".emplace()") {
+        auto it = array.emplace(array.cbegin() + 4, 99);
+
+        CHECK(*it == 99);
+        CHECK(array == sharray<int>({0, 1, 2, 3, 99, 4, 5, 6, 7, 8, 9}));
+    }
+    SECTION(".erase() near the front shifts the front elements") {
+        auto it = array.erase(array.cbegin() + 1);
+
+        CHECK(*it == 2);
+        CHECK(array.data() == data + 1);
+        CHECK(array == sharray<int>({0, 2, 3, 4, 5, 6, 7, 8, 9}));
+    }
+    SECTION(".erase() near the back shifts the back elements") {
+        auto it = array.erase(array.cbegin() + 7, array.cbegin() + 9);
+
+        CHECK(*it == 9);
+        CHECK(array.data() == data);
+        CHECK(array == sharray<int>({0, 1, 2, 3, 4, 5, 6, 9}));
+    }
+    SECTION(".erase() everything") {
+        auto it = array.erase(array.cbegin(), array.cend());
+
+        CHECK(it == array.end());
+        CHECK(array.empty());
+    }
+}
+
+TEST_CASE("sharray insertion and erasure of non-trivial types") {
+    std::vector<std::string> expected = {"a", "b", "c", "d", "e", "f"};
+    sharray<std::string> strings(expected.begin(), expected.end());
+    std::vector<ThrowingMove> expected_throwing = {1, 2, 3, 4, 5, 6};
+    sharray<ThrowingMove> throwing(expected_throwing.begin(), expected_throwing.end());
+
+    for (int i = 0; i < 50; i++) {
+        std::size_t position = (std::size_t)(i * 7) % (expected.size() + 1);
+        if (i % 3 == 2) {
+            position %= expected.size();
+            strings.erase(strings.cbegin() + (std::ptrdiff_t)position);
+            expected.erase(expected.begin() + (std::ptrdiff_t)position);
+            throwing.erase(throwing.cbegin() + (std::ptrdiff_t)position);
+            expected_throwing.erase(expected_throwing.begin() + (std::ptrdiff_t)position);
+        } else {
+            strings.insert(strings.cbegin() + (std::ptrdiff_t)position, std::to_string(i));
+            expected.insert(expected.begin() + (std::ptrdiff_t)position, std::to_string(i));
+            throwing.insert(throwing.cbegin() + (std::ptrdiff_t)position, i);
+            expected_throwing.insert(expected_throwing.begin() + (std::ptrdiff_t)position, i);
+        }
+    }
+
+    CHECK(std::vector<std::string>(strings.begin(), strings.end()) == expected);
+    CHECK(std::vector<ThrowingMove>(throwing.begin(), throwing.end()) == expected_throwing);
+}
+
+TEST_CASE("sharray constructs pushed elements in place") {
+    SECTION(".emplace_back() and .emplace_front() forward their arguments") {
+        sharray<std::string> array;
+
+        CHECK(array.emplace_back(3u, 'b') == "bbb");
+        CHECK(array.emplace_front(2u, 'f') == "ff");
+        CHECK(array == sharray<std::string>({"ff", "bbb"}));
+    }
+    SECTION("pushing rvalues and emplacing never copies") {
+        sharray<Counted> array;
+        Counted::reset();
+
+        for (int i = 0; i < 1000; i++) {
+            array.push_back(Counted(i));
+            array.push_front(Counted(-i));
+            array.emplace_back(i);
+            array.emplace_front(-i);
+        }
+
+        CHECK(Counted::copies == 0);
+        CHECK(array.size() == 4000);
+        CHECK(array.front().value == -999);
+        CHECK(array.back().value == 999);
+    }
+    SECTION("pushing an lvalue copies it exactly once") {
+        sharray<Counted> array;
+        Counted value(42);
+        Counted::reset();
+
+        array.push_back(value);
+        array.push_front(value);
+
+        CHECK(Counted::copies == 2);
+    }
+    SECTION("pushing one of its own elements when full") {
+        sharray<std::string> array = {"first", "second"};
+
+        array.push_back(array.front());
+        array.push_front(array.back());
+        array.emplace_back(array[1]);
+
+        CHECK(array == sharray<std::string>({"first", "first", "second", "first", "first"}));
+    }
+}
+
+TEST_CASE("sharray uses the allocator it is given") {
+    std::pmr::monotonic_buffer_resource arena;
+    std::pmr::monotonic_buffer_resource other_arena;
+    pmr::sharray<int> array({1, 2, 3, 4}, &arena);
+
+    SECTION("allocator-extended copy constructor") {
+        pmr::sharray<int> copy(array, &other_arena);
+
+        CHECK(copy == array);
+        CHECK(copy.get_allocator().resource() == &other_arena);
+    }
+    SECTION("copy constructor doesn't propagate a polymorphic allocator") {
+        pmr::sharray<int> copy = array;
+
+        CHECK(copy == array);
+        CHECK(copy.get_allocator().resource() == std::pmr::get_default_resource());
+    }
+    SECTION("allocator-extended move constructor with an equal allocator takes the storage") {
+        const int* elements = array.data();
+
+        pmr::sharray<int> moved(std::move(array), &arena);
+
+        CHECK(moved.data() == elements);
+        CHECK(moved == pmr::sharray<int>({1, 2, 3, 4}));
+    }
+    SECTION("allocator-extended move constructor with an unequal allocator moves each element") {
+        pmr::sharray<std::pmr::string> strings({"a string too long to be stored inline", "b"}, &arena);
+
+        pmr::sharray<std::pmr::string> moved(std::move(strings), &other_arena);
+
+        CHECK(moved.get_allocator().resource() == &other_arena);
+        // elements are constructed using the container's allocator
+        CHECK(moved.front().get_allocator().resource() == &other_arena);
+        CHECK(moved.front() == "a string too long to be stored inline");
+        CHECK(moved.back() == "b");
+        CHECK(strings.empty());
+    }
+    SECTION("move assignment between unequal allocators keeps the destination's allocator") {
+        pmr::sharray<int> destination({9, 9}, &other_arena);
+
+        destination = std::move(array);
+
+        CHECK(destination.get_allocator().resource() == &other_arena);
+        CHECK(destination == pmr::sharray<int>({1, 2, 3, 4}));
+    }
+    SECTION("copy assignment reuses storage when there's room") {
+        pmr::sharray<int> destination({9, 9, 9, 9, 9, 9}, &other_arena);
+        const int* storage = destination.data();
+
+        destination = array;
+
+        CHECK(destination == array);
+        CHECK(destination.data() >= storage);
+        CHECK(destination.data() + destination.size() <= storage + 6);
+    }
+}
+
+TEST_CASE("sharray can be grown without initialising the new elements") {
+    SECTION(".resize_for_overwrite() at the back") {
+        sharray<int> array = {1, 2};
+
+        array.resize_for_overwrite(5);
+        for (std::size_t i = 2; i < 5; i++) {
+            array[i] = (int)i + 1;
+        }
+
+        CHECK(array == sharray<int>({1, 2, 3, 4, 5}));
+    }
+    SECTION(".resize_for_overwrite() at both ends") {
+        sharray<int> array = {1, 2};
+
+        array.resize_for_overwrite({2, 3});
+        array[0] = -1;
+        array[1] = 0;
+        array[4] = 3;
+
+        CHECK(array == sharray<int>({-1, 0, 1, 2, 3}));
+    }
+    SECTION(".resize_for_overwrite() shrinking") {
+        sharray<int> array = {1, 2, 3, 4};
+
+        array.resize_for_overwrite(2);
+
+        CHECK(array == sharray<int>({1, 2}));
+    }
+    SECTION(".resize_for_overwrite() default-inserts non-trivial types") {
+        sharray<std::string> array = {"a"};
+
+        array.resize_for_overwrite({1, 2});
+
+        CHECK(array == sharray<std::string>({"", "a", ""}));
+    }
+    SECTION(".append_uninitialized() returns the new elements") {
+        sharray<char> array = {'a', 'b'};
+
+        std::span<char> appended = array.append_uninitialized(3);
+        REQUIRE(appended.size() == 3);
+        for (std::size_t i = 0; i < appended.size(); i++) {
+            appended[i] = (char)('c' + i);
+        }
+
+        CHECK(array == sharray<char>({'a', 'b', 'c', 'd', 'e'}));
+    }
+    SECTION("growing allocates once") {
+        CountingAllocator<int>::allocations = 0;
+        sharray<int, CountingAllocator<int>> array;
+
+        array.resize_for_overwrite({1000, 1000});
+
+        CHECK(array.size() == 2000);
+        CHECK(CountingAllocator<int>::allocations == 1);
+    }
+}
+
+TEST_CASE("sharray inserts ranges in bulk") {
+    CountingAllocator<int>::allocations = 0;
+    std::vector<int> source = {1, 2, 3, 4, 5, 6, 7, 8};
+
+    SECTION("iterator constructor allocates once for forward ranges") {
+        sharray<int, CountingAllocator<int>> array(source.begin(), source.end());
+
+        CHECK(CountingAllocator<int>::allocations == 1);
+        CHECK(array.capacity() == source.size());
+        CHECK(std::equal(array.begin(), array.end(), source.begin(), source.end()));
+    }
+    SECTION("iterator constructor with a single-pass range") {
+        std::istringstream input("4 5 6");
+
+        sharray<int> array{std::istream_iterator<int>(input), std::istream_iterator<int>()};
+
+        CHECK(array == sharray<int>({4, 5, 6}));
+    }
+    SECTION(".append_range()") {
+        sharray<int> array = {0};
+
+        array.append_range(source);
+
+        CHECK(array == sharray<int>({0, 1, 2, 3, 4, 5, 6, 7, 8}));
+    }
+    SECTION(".prepend_range() keeps the range's order") {
+        sharray<int> array = {9};
+
+        array.prepend_range(source);
+
+        CHECK(array == sharray<int>({1, 2, 3, 4, 5, 6, 7, 8, 9}));
+    }
+    SECTION(".prepend_range() allocates at most once") {
+        sharray<int, CountingAllocator<int>> array = {9};
+        CountingAllocator<int>::allocations = 0;
+
+        array.prepend_range(source);
+
+        CHECK(CountingAllocator<int>::allocations <= 1);
+    }
+    SECTION("ranges of non-trivial types and sentinels") {
+        sharray<std::string> array = {"middle"};
+
+        array.prepend_range(std::vector<std::string>{"first", "second"});
+        array.append_range(std::views::iota(0, 2) | std::views::transform([](int i) { return std::to_string(i); }));
+
+        CHECK(array == sharray<std::string>({"first", "second", "middle", "0", "1"}));
+    }
+    SECTION(".assign() from a range") {
+        sharray<int> array = {9, 9};
+
+        array.assign(source.begin(), source.end());
+
+        CHECK(std::equal(array.begin(), array.end(), source.begin(), source.end()));
+    }
+    SECTION(".assign() reuses storage when there's room") {
+        sharray<int, CountingAllocator<int>> array(source.begin(), source.end());
+        CountingAllocator<int>::allocations = 0;
+
+        array.assign({3, 2, 1});
+        array.assign(5u, 7);
+
+        CHECK(CountingAllocator<int>::allocations == 0);
+        CHECK(array == sharray<int, CountingAllocator<int>>({7, 7, 7, 7, 7}));
+    }
+    SECTION(".assign() with one of its own elements") {
+        sharray<std::string> array = {"a", "b"};
+
+        array.assign(3u, array.back());
+
+        CHECK(array == sharray<std::string>({"b", "b", "b"}));
+    }
+}
+
+namespace {
+    // grows to exactly what's needed, so every insertion beyond capacity reallocates
+    struct ExactGrowth {
+        static constexpr std::size_t capacity_for(std::size_t needed, std::size_t) {
+            return needed;
+        }
+    };
+
+    template <growth_policy GrowthPolicy>
+    using counted_sharray = sharray<int, CountingAllocator<int>, GrowthPolicy>;
+
+    // pushes count elements onto alternate ends
+    template <class Array>
+    Array push_alternately(std::size_t count) {
+        Array array;
+        for (std::size_t i = 0; i < count; i++) {
+            if (i % 2 == 0) {
+                array.push_back((int)i);
+            } else {
+                array.push_front((int)i);
+            }
+        }
+        return array;
+    }
+}
+
+TEST_CASE("sharray grows according to its growth policy") {
+    CountingAllocator<int>::allocations = 0;
+
+    SECTION("the default policy triples what's needed") {
+        STATIC_REQUIRE(std::is_same_v<sharray<int>, sharray<int, std::allocator<int>, growth_3x>>);
+
+        sharray<int> array = {1, 2, 3, 4};
+        array.push_back(5);
+
+        CHECK(array.capacity() == 15);
+    }
+    SECTION("geometric growth") {
+        counted_sharray<growth_2x> array = {1, 2, 3, 4};
+        array.push_back(5);
+
+        CHECK(array.capacity() == 10);
+
+        auto grown = push_alternately<counted_sharray<growth_1_5x>>(1000);
+
+        CHECK(grown.size() == 1000);
+        CHECK(grown.capacity() <= 1500);
+    }
+    SECTION("fixed increments") {
+        auto array = push_alternately<counted_sharray<fixed_growth<64>>>(1000);
+
+        CHECK(array.size() == 1000);
+        CHECK(array.capacity() <= 1000 + 64);
+    }
+    SECTION("powers of two") {
+        auto array = push_alternately<counted_sharray<power_of_two_growth>>(1000);
+
+        CHECK(array.size() == 1000);
+        CHECK(std::has_single_bit(array.capacity()));
+    }
+    SECTION("user-defined policies") {
+        auto array = push_alternately<counted_sharray<ExactGrowth>>(100);
+
+        CHECK(array.capacity() == 100);
+        CHECK(CountingAllocator<int>::allocations == 100);
+    }
+}
+
+TEST_CASE("sharray can give back storage") {
+    SECTION(".clear() destroys elements") {
+        sharray<std::string> array = {"a", "b", "c"};
+        std::size_t capacity = array.capacity();
+
+        array.clear();
+
+        CHECK(array.empty());
+        CHECK(array.capacity() == capacity);
+        array.push_front("front");
+        array.push_back("back");
+        CHECK(array == sharray<std::string>({"front", "back"}));
+    }
+    SECTION(".shrink_to_fit() with headroom") {
+        sharray<int> array(100);
+        array.resize(10);
+
+        array.shrink_to_fit({5, 3});
+
+        CHECK(array.capacity() == 18);
+        CHECK(array == sharray<int>(10));
+        // the headroom is where it was asked for
+        CountingAllocator<int>::allocations = 0;
+        sharray<int, CountingAllocator<int>> counted(10);
+        counted.push_back(1); // reallocates, leaving spare space
+        counted.shrink_to_fit({5, 3}); // reallocates to 19
+        for (int i = 0; i < 5; i++) {
+            counted.push_front(i);
+        }
+        for (int i = 0; i < 3; i++) {
+            counted.push_back(i);
+        }
+        CHECK(CountingAllocator<int>::allocations == 3);
+    }
+    SECTION(".shrink_to_fit() when empty frees the storage") {
+        sharray<int> array(100);
+        array.clear();
+
+        array.shrink_to_fit();
+
+        CHECK(array.capacity() == 0);
+    }
+    SECTION(".shrink_to_fit() never grows") {
+        sharray<int> array = {1, 2, 3};
+
+        array.shrink_to_fit({10, 10});
+
+        CHECK(array.capacity() == 3);
+    }
+    SECTION("auto_shrink shrinks when occupancy falls below the threshold") {
+        sharray<int, std::allocator<int>, auto_shrink<growth_2x, 25>> array(1000);
+
+        array.resize(300);
+        CHECK(array.capacity() == 1000);
+
+        array.erase(array.begin(), array.begin() + 51);
+        // to 2x, but no more than leaves it 62.5% full
+        CHECK(array.capacity() == 398);
+
+        // and not again until occupancy falls that low again
+        while (array.size() > 99) {
+            array.pop_back();
+        }
+        CHECK(array.capacity() == 398);
+        array.pop_front();
+        CHECK(array.capacity() == 156);
+
+        array.clear();
+        CHECK(array.capacity() == 0);
+    }
+    SECTION("auto_shrink doesn't thrash when growth would leave it below the threshold") {
+        // 3x growth leaves the array 33% full, below the 50% it shrinks at
+        sharray<int, CountingAllocator<int>, auto_shrink<default_growth, 50>> array;
+        for (int i = 0; i < 1000; i++) {
+            array.push_back(i);
+        }
+        CountingAllocator<int>::allocations = 0;
+        while (not array.empty()) {
+            array.pop_back();
+        }
+        // each shrink takes a third of what's left, so they're logarithmic in number
+        CHECK(CountingAllocator<int>::allocations <= 20);
+
+        for (int i = 0; i < 1000; i++) {
+            array.push_back(i);
+        }
+        CountingAllocator<int>::allocations = 0;
+        // insertions and removals just either side of where it last grew or shrank
+        for (int i = 0; i < 1000; i++) {
+            array.push_back(i);
+            array.pop_back();
+            array.pop_back();
+            array.push_back(i);
+        }
+        CHECK(CountingAllocator<int>::allocations <= 1);
+    }
+}
+
+namespace {
+    enum class Colour : std::uint16_t { RED, GREEN, BLUE, };
+
+    // checks find() and count() with every instruction set the CPU supports agree with a plain loop
+    template <typename T>
+    void check_search_levels(const std::vector<T>& haystack, const T& needle) {
+        std::size_t expected_index = (std::size_t)(std::find(haystack.begin(), haystack.end(), needle) - haystack.begin());
+        std::size_t expected_count = (std::size_t)std::count(haystack.begin(), haystack.end(), needle);
+        auto best = detail::detect_simd_level();
+        for (auto level : {detail::simd_level::SCALAR, detail::simd_level::SSE2, detail::simd_level::AVX2}) {
+            if (level > best) { break; }
+            CHECK(detail::find(level, haystack.data(), haystack.size(), needle) == expected_index);
+            CHECK(detail::count(level, haystack.data(), haystack.size(), needle) == expected_count);
+        }
+    }
+}
+
+TEST_CASE("sharray comparison") {
+    SECTION("equality of trivially comparable types") {
+        sharray<int> array = {1, 2, 3, 4};
+
+        CHECK(array == sharray<int>({1, 2, 3, 4}));
+        CHECK(array != sharray<int>({1, 2, 3, 5}));
+        CHECK(array != sharray<int>({1, 2, 3}));
+        CHECK(sharray<int>() == sharray<int>());
+    }
+    SECTION("three-way comparison") {
+        CHECK(sharray<int>({1, 2, 3}) < sharray<int>({1, 2, 4}));
+        CHECK(sharray<int>({-1, 2}) < sharray<int>({1}));
+        CHECK(sharray<int>({1, 2}) < sharray<int>({1, 2, 0}));
+        CHECK(sharray<int>({3}) > sharray<int>({1, 2, 3}));
+        CHECK((sharray<int>({1, 2}) <=> sharray<int>({1, 2})) == std::strong_ordering::equal);
+        CHECK(sharray<std::string>({"apple", "pear"}) < sharray<std::string>({"apple", "plum"}));
+        CHECK((sharray<double>({0.5}) <=> sharray<double>({0.25})) == std::partial_ordering::greater);
+    }
+    SECTION("three-way comparison of bytes") {
+        using bytes = sharray<unsigned char>;
+
+        CHECK(bytes({1, 2, 200}) > bytes({1, 2, 3}));
+        CHECK(bytes({1, 2}) < bytes({1, 2, 0}));
+        CHECK(bytes() < bytes({0}));
+        CHECK((bytes({7, 7}) <=> bytes({7, 7})) == std::strong_ordering::equal);
+    }
+    SECTION("comparison in constant expressions") {
+        STATIC_REQUIRE(sharray<int>({1, 2}) == sharray<int>({1, 2}));
+        STATIC_REQUIRE(sharray<unsigned char>({1, 2}) < sharray<unsigned char>({1, 3}));
+    }
+}
+
+TEST_CASE("sharray search") {
+    SECTION(".find(), .count() and .contains()") {
+        sharray<int> array = {5, 3, 9, 3, 7};
+
+        CHECK(array.find(3) == array.begin() + 1);
+        CHECK(array.find(4) == array.end());
+        CHECK(array.count(3) == 2);
+        CHECK(array.contains(7));
+        CHECK_FALSE(array.contains(8));
+    }
+    SECTION("non-trivially comparable types") {
+        const sharray<std::string> array = {"a", "b", "a"};
+
+        CHECK(array.find("b") == array.begin() + 1);
+        CHECK(array.count("a") == 2);
+        CHECK_FALSE(array.contains("c"));
+    }
+    SECTION("every instruction set gives the same results") {
+        std::size_t size = (std::size_t)GENERATE(0, 1, 7, 15, 16, 17, 31, 32, 33, 100);
+        std::size_t position = (std::size_t)GENERATE(0, 3, 15, 16, 31, 99);
+
+        std::vector<char> chars(size, 'x');
+        std::vector<std::int16_t> shorts(size, -1);
+        std::vector<Colour> colours(size, Colour::RED);
+        std::vector<std::uint32_t> words(size, 0xABCD1234);
+        std::vector<std::int64_t> longs(size, 1ll << 40);
+        if (position < size) {
+            chars[position] = 'y';
+            shorts[position] = 0x00FF;
+            colours[position] = Colour::BLUE;
+            // differs from the others in only one byte
+            words[position] = 0xABCD0034;
+            longs[position] = 1;
+            // a second match, to be counted
+            chars[size - 1] = 'y';
+            words[size - 1] = 0xABCD0034;
+        }
+        check_search_levels(chars, 'y');
+        check_search_levels(shorts, (std::int16_t)0x00FF);
+        check_search_levels(colours, Colour::BLUE);
+        check_search_levels(words, (std::uint32_t)0xABCD0034);
+        check_search_levels(longs, (std::int64_t)1);
+        // values which only partly match an element mustn't be found
+        check_search_levels(words, (std::uint32_t)0xABCD);
+    }
+    SECTION("counting many matches") {
+        check_search_levels(std::vector<char>(10000, 'y'), 'y');
+        check_search_levels(std::vector<std::int64_t>(10000, 1), (std::int64_t)1);
+    }
+    SECTION("search in constant expressions") {
+        STATIC_REQUIRE(sharray<int>({1, 2, 3}).contains(2));
+        STATIC_REQUIRE(sharray<int>({1, 2, 2}).count(2) == 2);
+    }
+}
+
+TEST_CASE("sharray can hand over and take over its storage") {
+    std::allocator<int> allocator;
+
+    SECTION(".data() can be written through") {
+        sharray<int> array(4, 0);
+        const int source[] = {1, 2, 3, 4};
+
+        std::memcpy(array.data(), source, sizeof(source));
+
+        CHECK(array == sharray<int>({1, 2, 3, 4}));
+    }
+    SECTION(".adopt() takes over a buffer without copying it") {
+        int* buffer = allocator.allocate(8);
+        for (int i = 0; i < 4; i++) {
+            buffer[2 + i] = i + 1;
+        }
+        sharray<int> array = {9, 9};
+
+        array.adopt(buffer, 8, 2, 4);
+
+        CHECK(array.data() == buffer + 2);
+        CHECK(array.capacity() == 8);
+        CHECK(array == sharray<int>({1, 2, 3, 4}));
+        // the spare space on either side can be grown into
+        array.push_front(0);
+        array.push_back(5);
+        CHECK(array.data() == buffer + 1);
+        CHECK(array == sharray<int>({0, 1, 2, 3, 4, 5}));
+    }
+    SECTION(".adopt() rejects elements outside the buffer") {
+        int* buffer = allocator.allocate(4);
+        sharray<int> array = {1, 2};
+
+        CHECK_THROWS_AS(array.adopt(buffer, 4, 2, 3), std::invalid_argument);
+        CHECK(array == sharray<int>({1, 2}));
+        allocator.deallocate(buffer, 4);
+    }
+    SECTION(".release() hands over the storage and leaves the sharray empty") {
+        sharray<std::string> array = {"a", "b", "c"};
+        array.push_front("z");
+        const std::string* front = array.data();
+
+        auto released = array.release();
+
+        CHECK(array.empty());
+        CHECK(array.capacity() == 0);
+        REQUIRE(released.size == 4);
+        CHECK(released.data + released.base == front);
+        CHECK(released.data[released.base] == "z");
+        CHECK(released.data[released.base + 3] == "c");
+        // released storage can be adopted again
+        sharray<std::string> other;
+        other.adopt(released.data, released.capacity, released.base, released.size);
+        CHECK(other == sharray<std::string>({"z", "a", "b", "c"}));
+    }
 }
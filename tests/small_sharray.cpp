@@ -0,0 +1,143 @@
+#include <cstddef>
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include <catch2/catch_all.hpp>
+
+#include <codlili/small_sharray.hpp>
+
+#include "helpers.hpp"
+
+
+using namespace com::saxbophone::codlili;
+
+namespace {
+    template <typename T, std::size_t N>
+    using counted_small_sharray = small_sharray<T, N, CountingAllocator<T>>;
+
+    // is the array's storage inside the array object itself?
+    template <class Array>
+    bool is_inline(const Array& array) {
+        auto object = reinterpret_cast<const std::byte*>(&array);
+        auto elements = reinterpret_cast<const std::byte*>(array.data());
+        return elements >= object and elements < object + sizeof(Array);
+    }
+}
+
+TEST_CASE("small_sharray stores up to N elements without allocating") {
+    CountingAllocator<int>::allocations = 0;
+
+    SECTION("pushing at both ends") {
+        counted_small_sharray<int, 8> array;
+        for (int i = 0; i < 4; i++) {
+            array.push_back(i);
+            array.push_front(-i);
+        }
+
+        CHECK(CountingAllocator<int>::allocations == 0);
+        CHECK(is_inline(array));
+        CHECK(array == counted_small_sharray<int, 8>({-3, -2, -1, 0, 0, 1, 2, 3}));
+    }
+    SECTION("constructing") {
+        counted_small_sharray<int, 8> sized(8, 5);
+        counted_small_sharray<int, 8> listed = {1, 2, 3, 4, 5, 6, 7, 8};
+        counted_small_sharray<int, 8> copied = listed;
+
+        CHECK(CountingAllocator<int>::allocations == 0);
+        CHECK(sized.capacity() == 8);
+        CHECK(copied == listed);
+    }
+    SECTION("inserting and erasing in the middle") {
+        counted_small_sharray<int, 8> array = {1, 2, 3, 4};
+
+        array.insert(array.begin() + 2, 2, 0);
+        array.erase(array.begin() + 1);
+
+        CHECK(CountingAllocator<int>::allocations == 0);
+        CHECK(array == counted_small_sharray<int, 8>({1, 0, 0, 3, 4}));
+    }
+}
+
+TEST_CASE("small_sharray spills onto the heap beyond N elements") {
+    CountingAllocator<std::string>::allocations = 0;
+    counted_small_sharray<std::string, 4> array = {"b", "c"};
+    array.push_front("a");
+    array.push_back("d");
+    REQUIRE(CountingAllocator<std::string>::allocations == 0);
+
+    array.push_back("e");
+
+    CHECK(CountingAllocator<std::string>::allocations == 1);
+    CHECK_FALSE(is_inline(array));
+    CHECK(array == counted_small_sharray<std::string, 4>({"a", "b", "c", "d", "e"}));
+    CHECK(array.capacity() > 4);
+}
+
+TEST_CASE("small_sharray can be copied, moved and swapped") {
+    small_sharray<std::string, 4> small = {"short", "list"};
+    small_sharray<std::string, 4> large = {"a", "much", "longer", "list", "of", "words"};
+
+    SECTION("move construction from inline storage moves the elements") {
+        small_sharray<std::string, 4> moved(std::move(small));
+
+        CHECK(is_inline(moved));
+        CHECK(moved == small_sharray<std::string, 4>({"short", "list"}));
+        CHECK(small.empty());
+        // the moved-from array is still usable
+        small.push_back("again");
+        CHECK(small.front() == "again");
+    }
+    SECTION("move construction from the heap takes the storage") {
+        const std::string* elements = large.data();
+
+        small_sharray<std::string, 4> moved(std::move(large));
+
+        CHECK(moved.data() == elements);
+        CHECK(moved.size() == 6);
+        CHECK(large.empty());
+    }
+    SECTION("move assignment") {
+        large = std::move(small);
+
+        CHECK(is_inline(large));
+        CHECK(large == small_sharray<std::string, 4>({"short", "list"}));
+    }
+    SECTION("copy construction of spilled arrays") {
+        small_sharray<std::string, 4> copied = large;
+
+        CHECK(copied == large);
+        CHECK(copied.data() != large.data());
+    }
+    SECTION("swap between inline and heap storage") {
+        small.swap(large);
+
+        CHECK(is_inline(large));
+        CHECK(large == small_sharray<std::string, 4>({"short", "list"}));
+        CHECK(small == small_sharray<std::string, 4>({"a", "much", "longer", "list", "of", "words"}));
+    }
+}
+
+TEST_CASE("small_sharray releases inline elements in allocated storage") {
+    small_sharray<std::string, 4> array = {"short", "list"};
+    REQUIRE(is_inline(array));
+
+    auto released = array.release();
+
+    CHECK(array.empty());
+    REQUIRE(released.size == 2);
+    auto start = reinterpret_cast<const std::byte*>(released.data);
+    auto object = reinterpret_cast<const std::byte*>(&array);
+    CHECK((start < object or start >= object + sizeof(array)));
+    CHECK(released.data[released.base] == "short");
+    CHECK(released.data[released.base + 1] == "list");
+    array.adopt(released.data, released.capacity, released.base, released.size);
+    CHECK_FALSE(is_inline(array));
+    CHECK(array == small_sharray<std::string, 4>({"short", "list"}));
+}
+
+TEST_CASE("small_sharray can be used in constant expressions") {
+    STATIC_REQUIRE(sum_of_pushes<small_sharray<int, 4>>(3) == 3);
+    STATIC_REQUIRE(sum_of_pushes<small_sharray<int, 4>>(10) == 45);
+}
@@ -0,0 +1,104 @@
+#include <cstddef>
+
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include <catch2/catch_all.hpp>
+
+#include <codlili/static_sharray.hpp>
+
+
+using namespace com::saxbophone::codlili;
+
+namespace {
+    // a table of squares, with the negative ones pushed onto the front
+    constexpr static_sharray<int, 16> make_squares() {
+        static_sharray<int, 16> squares;
+        for (int i = 0; i < 8; i++) {
+            squares.push_back(i * i);
+            if (i > 0) {
+                squares.push_front(-i * i);
+            }
+        }
+        return squares;
+    }
+
+    constexpr static_sharray<int, 16> SQUARES = make_squares();
+}
+
+TEST_CASE("static_sharray can be built at compile time and used at runtime") {
+    STATIC_REQUIRE(SQUARES.size() == 15);
+    STATIC_REQUIRE(SQUARES.front() == -49);
+    STATIC_REQUIRE(SQUARES[7] == 0);
+    STATIC_REQUIRE(SQUARES.back() == 49);
+    STATIC_REQUIRE(std::is_trivially_copyable_v<static_sharray<int, 16>>);
+
+    int sum = 0;
+    for (int square : SQUARES) {
+        sum += square;
+    }
+    CHECK(sum == 0);
+}
+
+TEST_CASE("static_sharray supports operations at both ends") {
+    static_sharray<std::string, 6> array = {"c", "d"};
+
+    SECTION("pushing and popping") {
+        array.push_front("b");
+        array.emplace_front(1u, 'a');
+        array.push_back("e");
+        array.emplace_back("f");
+
+        CHECK(array == static_sharray<std::string, 6>({"a", "b", "c", "d", "e", "f"}));
+
+        array.pop_front();
+        array.pop_back();
+
+        CHECK(array == static_sharray<std::string, 6>({"b", "c", "d", "e"}));
+    }
+    SECTION("elements slide along when one end is full") {
+        for (int i = 0; i < 4; i++) {
+            array.push_back("x");
+        }
+
+        CHECK(array == static_sharray<std::string, 6>({"c", "d", "x", "x", "x", "x"}));
+    }
+    SECTION("inserting and erasing") {
+        array.insert(array.begin() + 1, "between");
+        array.insert(array.begin(), array[1]);
+
+        CHECK(array == static_sharray<std::string, 6>({"between", "c", "between", "d"}));
+
+        array.erase(array.begin() + 1, array.begin() + 3);
+
+        CHECK(array == static_sharray<std::string, 6>({"between", "d"}));
+    }
+    SECTION("resizing") {
+        array.resize(5, "z");
+
+        CHECK(array == static_sharray<std::string, 6>({"c", "d", "z", "z", "z"}));
+
+        array.resize(1);
+
+        CHECK(array == static_sharray<std::string, 6>({"c"}));
+    }
+    SECTION("clearing") {
+        array.clear();
+
+        CHECK(array.empty());
+        CHECK(array.capacity() == 6);
+    }
+}
+
+TEST_CASE("static_sharray throws when its capacity would be exceeded") {
+    static_sharray<int, 4> array = {1, 2, 3, 4};
+
+    CHECK_THROWS_AS(array.push_back(5), std::length_error);
+    CHECK_THROWS_AS(array.push_front(0), std::length_error);
+    CHECK_THROWS_AS(array.insert(array.begin() + 2, 0), std::length_error);
+    CHECK_THROWS_AS(array.resize(5), std::length_error);
+    CHECK_THROWS_AS(array.at(4), std::out_of_range);
+    // nothing changed
+    CHECK(array == static_sharray<int, 4>({1, 2, 3, 4}));
+}
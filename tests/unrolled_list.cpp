@@ -0,0 +1,267 @@
+#include <cstddef>
+
+#include <iterator>
+#include <list>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include <codlili/unrolled_list.hpp>
+
+
+using namespace com::saxbophone::codlili;
+
+namespace {
+    template <class List>
+    std::vector<typename List::value_type> contents(const List& elements) {
+        return {elements.begin(), elements.end()};
+    }
+
+    // checks that elements and expected hold the same values, iterating both forwards and backwards
+    template <class List>
+    void check_same(const List& elements, const std::list<int>& expected) {
+        REQUIRE(elements.size() == expected.size());
+        REQUIRE(contents(elements) == std::vector<int>(expected.begin(), expected.end()));
+        REQUIRE(
+            std::vector<int>(elements.rbegin(), elements.rend()) ==
+            std::vector<int>(expected.rbegin(), expected.rend())
+        );
+    }
+
+    // a type which can't be stored in an unrolled_list, as moving it might throw
+    struct ThrowingMove {
+        ThrowingMove(ThrowingMove&&) {}
+    };
+
+    // a type which throws when it's been copied too many times, but can always be moved
+    struct ThrowingCopy {
+        static inline int copies_left = 0;
+
+        ThrowingCopy(int value) : value(value) {}
+        ThrowingCopy(const ThrowingCopy& other) : value(other.value) {
+            if (copies_left == 0) {
+                throw std::runtime_error("out of copies");
+            }
+            copies_left--;
+        }
+        ThrowingCopy(ThrowingCopy&&) noexcept = default;
+        ThrowingCopy& operator=(const ThrowingCopy&) = default;
+        bool operator==(const ThrowingCopy&) const = default;
+
+        int value;
+    };
+
+    template <typename T>
+    concept storable = requires { typename unrolled_list<T, 8>; };
+
+    constexpr int sum_after_edits(int count) {
+        unrolled_list<int, 4> elements;
+        for (int i = 0; i < count; i++) {
+            elements.push_back(i);
+            elements.push_front(-i);
+        }
+        // erase every other element, then insert before every remaining one
+        for (auto it = elements.begin(); it != elements.end(); ) {
+            it = elements.erase(it);
+            if (it != elements.end()) {
+                ++it;
+            }
+        }
+        for (auto it = elements.begin(); it != elements.end(); ++it) {
+            it = elements.insert(it, 1000);
+            ++it;
+        }
+        int sum = 0;
+        for (int element : elements) {
+            sum += element;
+        }
+        return sum;
+    }
+}
+
+static_assert(sum_after_edits(50) == 50025);
+
+TEST_CASE("unrolled_list mirrors the API of list") {
+    SECTION("construction") {
+        CHECK(unrolled_list<int>().empty());
+        CHECK(contents(unrolled_list<int>(3, 7)) == std::vector<int>{7, 7, 7});
+        CHECK(contents(unrolled_list<int>(2)) == std::vector<int>{0, 0});
+        CHECK(contents(unrolled_list<int>{1, 2, 3}) == std::vector<int>{1, 2, 3});
+        std::vector<int> values = {4, 5};
+        CHECK(contents(unrolled_list<int>(values.begin(), values.end())) == values);
+    }
+
+    SECTION("element access") {
+        unrolled_list<int, 4> elements = {1, 2, 3, 4, 5, 6};
+        CHECK(elements.front() == 1);
+        CHECK(elements.back() == 6);
+        elements.front() = 10;
+        *std::next(elements.begin(), 4) = 50;
+        CHECK(contents(elements) == std::vector<int>{10, 2, 3, 4, 50, 6});
+    }
+
+    SECTION("copying, moving and swapping") {
+        unrolled_list<std::string, 4> elements = {"a", "b", "c", "d", "e"};
+        unrolled_list<std::string, 4> copy = elements;
+        CHECK(copy == elements);
+        unrolled_list<std::string, 4> moved = std::move(elements);
+        CHECK(moved == copy);
+        CHECK(elements.empty());
+        elements.push_back("z");
+        CHECK(elements.size() == 1);
+        elements = std::move(moved);
+        CHECK(elements == copy);
+        copy = {"x"};
+        elements.swap(copy);
+        CHECK(contents(elements) == std::vector<std::string>{"x"});
+        CHECK(copy.size() == 5);
+        copy = copy;
+        CHECK(copy.size() == 5);
+    }
+
+    SECTION("comparison") {
+        CHECK(unrolled_list<int>{1, 2} < unrolled_list<int>{1, 3});
+        CHECK(unrolled_list<int>{1, 2} != unrolled_list<int>{1, 2, 3});
+        CHECK(unrolled_list<int>{1, 2} == unrolled_list<int>{1, 2});
+    }
+}
+
+TEST_CASE("unrolled_list behaves like std::list under insertion and erasure") {
+    unrolled_list<int, 8> elements;
+    std::list<int> expected;
+    std::size_t count = (std::size_t)GENERATE(1, 7, 8, 9, 100, 1000);
+
+    SECTION("pushing and popping at both ends") {
+        for (std::size_t i = 0; i < count; i++) {
+            elements.push_back((int)i);
+            expected.push_back((int)i);
+            elements.emplace_front(-(int)i);
+            expected.push_front(-(int)i);
+        }
+        check_same(elements, expected);
+        while (not expected.empty()) {
+            if (expected.size() % 3 == 0) {
+                elements.pop_back();
+                expected.pop_back();
+            } else {
+                elements.pop_front();
+                expected.pop_front();
+            }
+            check_same(elements, expected);
+        }
+    }
+
+    SECTION("inserting and erasing at iterators") {
+        for (std::size_t i = 0; i < count; i++) {
+            elements.push_back((int)i);
+            expected.push_back((int)i);
+        }
+        // insert two elements before every third one, splitting nodes as they fill
+        auto it = elements.begin();
+        auto expected_it = expected.begin();
+        for (std::size_t i = 0; expected_it != expected.end(); i++) {
+            if (i % 3 == 0) {
+                it = elements.insert(it, -1);
+                it = elements.insert(it, -2);
+                expected_it = expected.insert(expected_it, -1);
+                expected_it = expected.insert(expected_it, -2);
+                REQUIRE(*it == -2);
+                std::advance(it, 2);
+                std::advance(expected_it, 2);
+            }
+            ++it;
+            ++expected_it;
+        }
+        CHECK(it == elements.end());
+        check_same(elements, expected);
+
+        // erase runs of elements, merging nodes as they empty
+        it = elements.begin();
+        expected_it = expected.begin();
+        for (std::size_t i = 0; expected_it != expected.end(); i++) {
+            if (i % 4 == 3) {
+                ++it;
+                ++expected_it;
+                continue;
+            }
+            auto last = std::next(it, std::min<std::ptrdiff_t>(2, std::distance(expected_it, expected.end())));
+            auto expected_last = std::next(
+                expected_it, std::min<std::ptrdiff_t>(2, std::distance(expected_it, expected.end()))
+            );
+            it = elements.erase(it, last);
+            expected_it = expected.erase(expected_it, expected_last);
+            REQUIRE((it == elements.end()) == (expected_it == expected.end()));
+            if (it != elements.end()) {
+                REQUIRE(*it == *expected_it);
+            }
+        }
+        check_same(elements, expected);
+
+        // then empty it from the middle
+        while (not expected.empty()) {
+            auto middle = std::next(elements.begin(), (std::ptrdiff_t)elements.size() / 2);
+            auto expected_middle = std::next(expected.begin(), (std::ptrdiff_t)expected.size() / 2);
+            middle = elements.erase(middle);
+            expected_middle = expected.erase(expected_middle);
+            REQUIRE((middle == elements.end()) == (expected_middle == expected.end()));
+            check_same(elements, expected);
+        }
+        CHECK(elements.begin() == elements.end());
+    }
+
+    SECTION("resizing and clearing") {
+        elements.resize(count, 3);
+        expected.resize(count, 3);
+        check_same(elements, expected);
+        elements.resize(count / 2);
+        expected.resize(count / 2);
+        check_same(elements, expected);
+        elements.clear();
+        CHECK(elements.empty());
+        elements.push_back(1);
+        CHECK(elements.front() == 1);
+    }
+}
+
+TEST_CASE("unrolled_list can insert an element which is already in it") {
+    unrolled_list<std::string, 4> elements = {"a", "b", "c", "d"};
+    elements.insert(std::next(elements.begin()), elements.back());
+    elements.push_front(elements.back());
+    CHECK(contents(elements) == std::vector<std::string>{"d", "a", "d", "b", "c", "d"});
+}
+
+TEST_CASE("unrolled_list only holds elements which can be moved without throwing") {
+    STATIC_REQUIRE(storable<ThrowingCopy>);
+    STATIC_REQUIRE(not storable<ThrowingMove>);
+}
+
+TEST_CASE("unrolled_list is left unchanged when copying an element into it throws") {
+    ThrowingCopy::copies_left = 100;
+    unrolled_list<ThrowingCopy, 8> elements;
+    for (int i = 0; i < 8; i++) {
+        elements.push_back(i);
+    }
+    auto before = contents(elements);
+    ThrowingCopy::copies_left = 0;
+    ThrowingCopy inserted(100);
+
+    // into the middle of a full node, which would split it
+    CHECK_THROWS_AS(elements.insert(std::next(elements.begin(), 3), inserted), std::runtime_error);
+    CHECK_THROWS_AS(elements.push_front(inserted), std::runtime_error);
+    CHECK_THROWS_AS(elements.push_back(inserted), std::runtime_error);
+
+    CHECK(elements.size() == 8);
+    ThrowingCopy::copies_left = 100;
+    CHECK(contents(elements) == before);
+    CHECK(
+        std::vector<ThrowingCopy>(elements.rbegin(), elements.rend()) ==
+        std::vector<ThrowingCopy>(before.rbegin(), before.rend())
+    );
+}
+
+TEST_CASE("unrolled_list is usable in constant expressions") {
+    STATIC_REQUIRE(sum_after_edits(10) == 10005);
+}